@@ -0,0 +1,147 @@
+#include "FPClassSections.h"
+
+#include "Editor.h"
+#include "PropertyEditorModule.h"
+#include "Engine/Blueprint.h"
+#include "Misc/App.h"
+#include "UObject/UObjectHash.h"
+
+void FFPClassSections::Start()
+{
+	// only the project's own modules are searched, instead of every class in the engine
+	TArray<FModuleStatus> Modules;
+	FModuleManager::Get().QueryModules(Modules);
+	for (const FModuleStatus& Module : Modules)
+	{
+		const FName ModuleName(Module.Name);
+		if (Module.bIsLoaded && IsProjectModule(ModuleName))
+		{
+			RegisterModule(ModuleName);
+		}
+	}
+
+	FModuleManager::Get().OnModulesChanged().AddRaw(this, &FFPClassSections::HandleModulesChanged);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FFPClassSections::HandleReloadComplete);
+	FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FFPClassSections::HandleAssetLoaded);
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().AddRaw(this, &FFPClassSections::HandleBlueprintPreCompile);
+	}
+}
+
+void FFPClassSections::Stop()
+{
+	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.RemoveAll(this);
+	FCoreUObjectDelegates::OnAssetLoaded.RemoveAll(this);
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().RemoveAll(this);
+	}
+}
+
+void FFPClassSections::RegisterModule(FName ModuleName)
+{
+	ProjectModules.Add(ModuleName);
+
+	TStringBuilder<256> PackageName;
+	PackageName << TEXT("/Script/") << ModuleName;
+
+	UPackage* Package = FindPackage(nullptr, *PackageName);
+	if (!Package)
+	{
+		return;
+	}
+
+	ForEachObjectWithPackage(Package, [this](UObject* Object)
+	{
+		if (const UClass* Class = Cast<UClass>(Object))
+		{
+			RegisterClass(Class);
+		}
+		return true;
+	}, false);
+}
+
+void FFPClassSections::RegisterClass(const UClass* Class)
+{
+	bool bAlreadyRegistered = false;
+	RegisteredClasses.Add(Class->GetFName(), &bAlreadyRegistered);
+	if (bAlreadyRegistered)
+	{
+		return;
+	}
+
+	FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	const TSharedRef<FPropertySection> Section = PropertyModule.FindOrCreateSection(
+		Class->GetFName(),
+		TEXT("MyProject"),
+		INVTEXT("🍩Project")
+	);
+
+	Section->AddCategory(TEXT("Default"));
+	Section->AddCategory(Class->GetFName());
+}
+
+bool FFPClassSections::IsProjectModule(FName ModuleName) const
+{
+	const FNameBuilder Name(ModuleName);
+	return Name.ToView().StartsWith(FApp::GetProjectName());
+}
+
+bool FFPClassSections::IsProjectPackage(const UPackage* Package)
+{
+	const FName PackageName = Package->GetFName();
+	if (const bool* bIsProject = ProjectPackages.Find(PackageName))
+	{
+		return *bIsProject;
+	}
+
+	const FNameBuilder Name(PackageName);
+	const FStringView View = Name.ToView();
+
+	bool bIsProject = View.StartsWith(TEXT("/Game/"));
+	if (!bIsProject && View.StartsWith(TEXT("/Script/")))
+	{
+		bIsProject = View.RightChop(8).StartsWith(FApp::GetProjectName());
+	}
+
+	ProjectPackages.Add(PackageName, bIsProject);
+	return bIsProject;
+}
+
+void FFPClassSections::HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason == EModuleChangeReason::ModuleLoaded && IsProjectModule(ModuleName))
+	{
+		RegisterModule(ModuleName);
+	}
+}
+
+void FFPClassSections::HandleReloadComplete(EReloadCompleteReason Reason)
+{
+	// live coding and hot reload add classes to the modules already loaded
+	for (FName ModuleName : ProjectModules.Array())
+	{
+		RegisterModule(ModuleName);
+	}
+}
+
+void FFPClassSections::HandleAssetLoaded(UObject* Asset)
+{
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+	{
+		HandleBlueprintPreCompile(Blueprint);
+	}
+}
+
+void FFPClassSections::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	// new Blueprints have a generated class by the time they are compiled again
+	if (Blueprint && Blueprint->GeneratedClass && IsProjectPackage(Blueprint->GetPackage()))
+	{
+		RegisterClass(Blueprint->GeneratedClass);
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+class UBlueprint;
+
+/**
+ * Adds the project details section to project classes as they appear: the project's native modules when they load
+ * or reload, and project Blueprints when they load or compile
+ */
+class FFPClassSections
+{
+public:
+	void Start();
+	void Stop();
+
+private:
+	void RegisterModule(FName ModuleName);
+	void RegisterClass(const UClass* Class);
+	bool IsProjectModule(FName ModuleName) const;
+	bool IsProjectPackage(const UPackage* Package);
+
+	void HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	void HandleReloadComplete(EReloadCompleteReason Reason);
+	void HandleAssetLoaded(UObject* Asset);
+	void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+
+	TSet<FName> RegisteredClasses;
+	TSet<FName> ProjectModules;
+
+	/** Whether each package seen so far belongs to the project, the classes of a package share the answer */
+	TMap<FName, bool> ProjectPackages;
+};
@@ -26,14 +26,22 @@ public class FPEditorUtilities : ModuleRules
 				"GameplayAbilities",
 				"GameplayAbilitiesEditor",
 				"UnrealEd",
+				"EditorSubsystem",
 				"Blutility",
 				"AssetTools",
 				"CurveTableEditor",
 				"HTTP",
+				"HTTPServer",
+				"Sockets",
+				"Json",
+				"JsonUtilities",
+				"DesktopPlatform",
 				"ToolMenus",
 				"UnrealEd",
 				"GameplayTags",
 				"GameplayTagsEditor",
+				"SourceControl",
+				"DirectoryWatcher",
 
 				// Object table
 				"WorkspaceMenuStructure",
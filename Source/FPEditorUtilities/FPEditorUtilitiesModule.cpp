@@ -2,13 +2,24 @@
 
 #include "AssetToolsModule.h"
 #include "DataTableEditorUtils.h"
+#include "Editor.h"
+#include "FPClassSections.h"
 #include "FPEditorUtilitySettings.h"
-#include "GameplayTagsEditorModule.h"
+#include "FPStartupTasks.h"
 #include "GameplayTagsManager.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "GameplayTags/FPTagFileWatcher.h"
+#include "GameplayTags/FPTagSources.h"
+#include "GameplayTags/FPTagUsageIndex.h"
+#include "LoadDataURL/FPImportJobs.h"
 #include "LoadDataURL/FPLoadDataURL_CurveTable.h"
 #include "LoadDataURL/FPLoadDataURL_DataTable.h"
+#include "LoadDataURL/FPTableExport.h"
+#include "LoadDataURL/FPTableMemoryReport.h"
+#include "Misc/TransactionObjectEvent.h"
 #include "ObjectTableEditor/FPObjectTableActions.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Subsystems/ImportSubsystem.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
 #define LOCTEXT_NAMESPACE "FFPEditorUtilitiesModule"
@@ -25,20 +36,127 @@ void FFPEditorUtilitiesModule::StartupModule()
 
 void FFPEditorUtilitiesModule::ShutdownModule()
 {
+	// drop the deferred startup steps which haven't run
+	FFPStartupTasks::TearDown();
+
 	if (FModuleManager::Get().IsModuleLoaded("AssetTools") && ObjectTableActions.IsValid())
 	{
 		FAssetToolsModule::GetModule().Get().UnregisterAssetTypeActions(ObjectTableActions.ToSharedRef());
 	}
+
+	TagFileWatcher.Reset();
+	CancelTableLoads();
+
+	for (const TPair<TWeakObjectPtr<UDataTable>, FFPBoundTagTable>& BoundTable : BoundTables)
+	{
+		if (BoundTable.Key.IsValid())
+		{
+			BoundTable.Key->OnDataTableChanged().RemoveAll(this);
+		}
+	}
+
+	BoundTables.Empty();
+	FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+
+	if (GEditor)
+	{
+		if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			ImportSubsystem->OnAssetReimport.RemoveAll(this);
+		}
+	}
+
+	if (ClassSections.IsValid())
+	{
+		ClassSections->Stop();
+		ClassSections.Reset();
+	}
+
+	FFPTagUsageIndex::TearDown();
+
+	if (ExportServer.IsValid())
+	{
+		ExportServer->Stop();
+		ExportServer.Reset();
+	}
+
+	if (FSlateApplication::IsInitialized())
+	{
+		FFPImportJobManager::Get().UnregisterTabSpawner();
+		FPTableMemoryReport::UnregisterTabSpawner();
+	}
 }
 
 void FFPEditorUtilitiesModule::OnPostEngineInit()
 {
-	FFPLoadDataURL_CurveTable::Get().Init();
-	FFPLoadDataURL_DataTable::Get().Init();
+	TRACE_CPUPROFILER_EVENT_SCOPE(FFPEditorUtilitiesModule::OnPostEngineInit);
+
+	FFPStartupTasks& Startup = FFPStartupTasks::Get();
+
+	// the editor layout may restore these tabs and asset editors on the first frame
+	Startup.RunNow(TEXT("Tab spawners"), []
+	{
+		FFPImportJobManager::Get().RegisterTabSpawner();
+		FPTableMemoryReport::RegisterTabSpawner();
+	});
+
+	Startup.RunNow(TEXT("Asset editor toolbars"), []
+	{
+		FFPLoadDataURL_CurveTable::Get().Init();
+		FFPLoadDataURL_DataTable::Get().Init();
+	});
+
+	Startup.RunNow(TEXT("Tools menu"), [this] { RegisterToolsMenu(); });
+
+	Startup.Defer(TEXT("Content Browser extenders"), []
+	{
+		FFPLoadDataURL_CurveTable::Get().RegisterContentBrowserExtender();
+		FFPLoadDataURL_DataTable::Get().RegisterContentBrowserExtender();
+	});
+
+	Startup.Defer(TEXT("Export server"), [this]
+	{
+		if (UFPEditorUtilitySettings::Get().bEnableExportServer)
+		{
+			ExportServer = MakeShared<FFPTableExportServer>();
+			ExportServer->Start(UFPEditorUtilitySettings::Get().ExportServerPort);
+		}
+	});
+
+	// reload tag files when they change on disk
+	Startup.Defer(TEXT("Tag file watcher"), [this]
+	{
+		TagFileWatcher = MakeUnique<FFPTagFileWatcher>();
+		TagFileWatcher->Start();
+	});
+
+	// project classes get their details section as their modules and Blueprints load
+	Startup.Defer(TEXT("Class sections"), [this]
+	{
+		ClassSections = MakeUnique<FFPClassSections>();
+		ClassSections->Start();
+	});
+
+	Startup.Defer(TEXT("Bind tag tables"), [this]
+	{
+		BindTables();
+		UFPEditorUtilitySettings::GetMutable().OnTablesChanged.AddRaw(this, &FFPEditorUtilitiesModule::BindTables);
 
+		// an undo or a reimport can rename rows without changing their count, which HandleTableChanged would skip
+		FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FFPEditorUtilitiesModule::HandleObjectTransacted);
+		GEditor->GetEditorSubsystem<UImportSubsystem>()->OnAssetReimport.AddRaw(this, &FFPEditorUtilitiesModule::HandleAssetReimport);
+	});
+
+	Startup.Defer(TEXT("Tag usage index"), []
+	{
+		FFPTagUsageIndex::Get().Start();
+	});
+}
+
+void FFPEditorUtilitiesModule::RegisterToolsMenu()
+{
 	UToolMenu* HelpMenu = UToolMenus::Get()->ExtendMenu("LevelEditor.MainMenu.Tools");
 	FToolMenuSection& Section = HelpMenu->AddSection("Reload Gameplay Tags", INVTEXT("ReloadGameplayTags"));
-	RegisterGameCategory();
 
 	FToolMenuOwnerScoped OwnerScoped(this);
 	{
@@ -51,162 +169,252 @@ void FFPEditorUtilitiesModule::OnPostEngineInit()
 			{
 				// UE_LOG(LogTemp, Warning, TEXT("Reloading tags"));
 
-				TArray<FString> OutPaths;
-				UGameplayTagsManager::Get().GetTagSourceSearchPaths(OutPaths);
-
-				TArray<const FGameplayTagSource*> AllSources;
-				UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::DefaultTagList, AllSources);
-				UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::RestrictedTagList, AllSources);
-				UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::TagList, AllSources);
-
-				for (const FGameplayTagSource* TagSource : AllSources) 
+				TArray<FString> ConfigFileNames;
+				for (const FGameplayTagSource* TagSource : FPTagSources::GetINISources())
 				{
-					GConfig->LoadFile(TagSource->GetConfigFileName());
-					
-					FText Msg = FText::FromString(FString::Printf(TEXT("Reloaded %s"), *TagSource->GetConfigFileName()));
-					FNotificationInfo Notification(Msg);
-					Notification.ExpireDuration = 5.0f;
-					FSlateNotificationManager::Get().AddNotification(Notification);
+					ConfigFileNames.Add(TagSource->GetConfigFileName());
 				}
 
-				UGameplayTagsManager::Get().EditorRefreshGameplayTagTree();
+				FPTagSources::ReloadFiles(ConfigFileNames);
 			}))
 		));
 		MenuEntry.InsertPosition = FToolMenuInsert(NAME_None, EToolMenuInsertType::First);
 	}
+}
 
-	// check tag files changed on a timer
-	GEditor->GetTimerManager()->SetTimer(UpdateTimer, FTimerDelegate::CreateRaw(this, &FFPEditorUtilitiesModule::CheckTagFiles), 2.0f, true);
-
-	BindTables();
-	UFPEditorUtilitySettings::GetMutable().OnTablesChanged.AddRaw(this, &FFPEditorUtilitiesModule::BindTables);
+static FName GetTagSourceName(const FDataTableTags& TablesUsingGameplayTag)
+{
+	// the tag source is the file name of the INI
+	FString TagSource = TablesUsingGameplayTag.TagPath.FilePath;
+	FString Left;
+	TablesUsingGameplayTag.TagPath.FilePath.Split("/", &Left, &TagSource, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	return TagSource.IsEmpty() ? NAME_None : FName(TagSource);
 }
 
-void FFPEditorUtilitiesModule::CheckTagFiles()
+void FFPEditorUtilitiesModule::ReadTableFiles(UDataTable* Table)
 {
-	TArray<FString> OutPaths;
-	UGameplayTagsManager::Get().GetTagSourceSearchPaths(OutPaths);
+	const FName* TagSourcePtr = TableTagSources.Find(FSoftObjectPath(Table));
+	if (!TagSourcePtr)
+	{
+		return; 
+	}
 
-	TArray<const FGameplayTagSource*> AllSources;
-	UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::DefaultTagList, AllSources);
-	UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::RestrictedTagList, AllSources);
-	UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::TagList, AllSources);
+	const FName TagSource = *TagSourcePtr;
 
-	bool bChanged = false;
-	for (const FGameplayTagSource* TagSource : AllSources) 
+	// only rows which weren't synced before (added or renamed) can be new tags
+	FFPBoundTagTable& BoundTable = BoundTables.FindOrAdd(Table);
+	TSet<FName>& SyncedRows = BoundTable.SyncedRows;
+	const TMap<FName, uint8*>& RowMap = Table->GetRowMap();
+	BoundTable.NumRows = RowMap.Num();
+
+	// collect every new tag first, adding them one at a time rewrites the INI and refreshes the tag tree per tag
+	TArray<FString> NewTags;
+	for (const TPair<FName, uint8*>& Row : RowMap)
 	{
-		FString TagFile = TagSource->GetConfigFileName();
+		const FName RowName = Row.Key;
+		if (SyncedRows.Contains(RowName))
+		{
+			continue;
+		}
 
-		if (IFileManager::Get().FileExists(*TagFile))
+		FString RowStr = RowName.ToString();
+		if (RowStr.Contains("RowName") || UGameplayTagsManager::Get().IsDictionaryTag(RowName))
 		{
-			const FDateTime FoundFileTime = IFileManager::Get().GetTimeStamp(*TagFile);
+			SyncedRows.Add(RowName);
+			continue;
+		}
 
-			FTimespan Delta = FDateTime::UtcNow() - FoundFileTime;
+		NewTags.Add(MoveTemp(RowStr));
+	}
 
-			if (Delta.GetTotalSeconds() <= 3.f)
+	// forget removed rows, so adding one back checks it again
+	if (SyncedRows.Num() > RowMap.Num())
+	{
+		for (auto It = SyncedRows.CreateIterator(); It; ++It)
+		{
+			if (!RowMap.Contains(*It))
 			{
-				// UE_LOG(LogTemp, Warning, TEXT("%s, %s %d %f"), *FoundFileTime.ToString(), *FDateTime::UtcNow().ToString(), Delta.GetSeconds(), Delta.GetTotalSeconds());
-				GConfig->LoadFile(TagSource->GetConfigFileName());
-
-				FText Msg = FText::FromString(FString::Printf(TEXT("Reloaded %s"), *TagSource->GetConfigFileName()));
-				// UE_LOG(LogTemp, Warning, TEXT("%s"), *Msg);
-				FNotificationInfo Notification(Msg);
-				Notification.ExpireDuration = 5.0f;
-				FSlateNotificationManager::Get().AddNotification(Notification);
-				bChanged = true;
+				It.RemoveCurrent();
 			}
 		}
 	}
 
-	if (bChanged)
+	if (NewTags.IsEmpty())
 	{
-		UGameplayTagsManager::Get().EditorRefreshGameplayTagTree();
+		return;
+	}
+
+	// rows whose tag wasn't added (the write failed or the tag was refused) stay unsynced, so the next change tries them again.
+	// adding the tags refreshes the tag tree, so the bound table is looked up again afterwards
+	const TArray<FString> AddedTags = FPTagSources::AddTags(TagSource, NewTags);
+	if (FFPBoundTagTable* AddedToTable = BoundTables.Find(Table))
+	{
+		for (const FString& Tag : AddedTags)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Auto added new tag %s"), *Tag);
+			AddedToTable->SyncedRows.Add(FName(Tag));
+		}
 	}
 }
 
-void FFPEditorUtilitiesModule::ReadTableFiles(UDataTable* Table)
+void FFPEditorUtilitiesModule::HandleTableChanged(UDataTable* Table)
 {
-	FString TagSource = "";
+	// this fires for value edits as well, only a changed row count is worth comparing the rows for
+	const FFPBoundTagTable* BoundTable = BoundTables.Find(Table);
+	if (BoundTable && BoundTable->NumRows != Table->GetRowMap().Num())
+	{
+		ReadTableFiles(Table);
+	}
+}
+
+void FFPEditorUtilitiesModule::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+	UDataTable* Table = Cast<UDataTable>(Object);
+	if (Table && Event.GetEventType() == ETransactionObjectEventType::UndoRedo && BoundTables.Contains(Table))
+	{
+		ReadTableFiles(Table);
+	}
+}
+
+void FFPEditorUtilitiesModule::HandleAssetReimport(UObject* Asset)
+{
+	UDataTable* Table = Cast<UDataTable>(Asset);
+	if (Table && BoundTables.Contains(Table))
+	{
+		ReadTableFiles(Table);
+	}
+}
+
+void FFPEditorUtilitiesModule::PostChange(const UDataTable* Changed, FDataTableEditorUtils::EDataTableChangeInfo Info)
+{
+	// editing the values of a row can't add a tag, only adding or renaming rows can
+	if (Info != FDataTableEditorUtils::EDataTableChangeInfo::RowList)
+	{
+		return;
+	}
+
+	UDataTable* Table = const_cast<UDataTable*>(Changed);
+	if (BoundTables.Contains(Table))
+	{
+		ReadTableFiles(Table);
+	}
+}
+
+void FFPEditorUtilitiesModule::BindTables()
+{
+	// resolved once per settings change, a later entry for the same table wins
+	TMap<FSoftObjectPath, FName> NewTableTagSources;
 	for (auto& TablesUsingGameplayTag : UFPEditorUtilitySettings::Get().TablesUsingGameplayTags)
 	{
-		if (TablesUsingGameplayTag.DataTable.LoadSynchronous() == Table)
+		const FName TagSource = GetTagSourceName(TablesUsingGameplayTag);
+		if (!TablesUsingGameplayTag.DataTable.IsNull() && !TagSource.IsNone())
 		{
-			TagSource = TablesUsingGameplayTag.TagPath.FilePath;
-			FString Left;
-			TablesUsingGameplayTag.TagPath.FilePath.Split("/", &Left, &TagSource, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+			NewTableTagSources.Add(TablesUsingGameplayTag.DataTable.ToSoftObjectPath(), TagSource);
 		}
 	}
 
-	if (TagSource.IsEmpty())
+	// only tables which were added, removed or moved to another tag source are touched
+	int32 NumUnbound = 0;
+	for (const TPair<FSoftObjectPath, FName>& OldTable : TableTagSources)
 	{
-		return; 
+		if (!NewTableTagSources.Contains(OldTable.Key))
+		{
+			UnbindTable(OldTable.Key);
+			++NumUnbound;
+		}
 	}
 
-	for (FName RowName : Table->GetRowNames())
+	TArray<FSoftObjectPath> TablesToSync;
+	for (const TPair<FSoftObjectPath, FName>& NewTable : NewTableTagSources)
 	{
-		FString RowStr = RowName.ToString();
-		if (RowStr.Contains("RowName"))
+		const FName* OldTagSource = TableTagSources.Find(NewTable.Key);
+		if (!OldTagSource || *OldTagSource != NewTable.Value)
 		{
-			continue;
+			// forget the synced rows, every row is checked against the new tag source
+			UnbindTable(NewTable.Key);
+			TablesToSync.Add(NewTable.Key);
 		}
+	}
 
-		if (UGameplayTagsManager::Get().IsDictionaryTag(FName(RowStr)))
-		{
-			continue;
-		}
+	TableTagSources = MoveTemp(NewTableTagSources);
 
-		UE_LOG(LogTemp, Log, TEXT("Auto added new tag %s"), *RowStr);
-		IGameplayTagsEditorModule::Get().AddNewGameplayTagToINI(RowStr, "", FName(TagSource));
+	if (TablesToSync.Num() || NumUnbound)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Tag tables: %d bound, %d to sync, %d unbound"), TableTagSources.Num(), TablesToSync.Num(), NumUnbound);
 	}
-}
 
-void FFPEditorUtilitiesModule::BindTables()
-{
-	for (auto Table : BoundTables)
+	// the tables load in the background, each is synced (and then tracked for added rows, see PostChange) once loaded.
+	// load times are measured from the first request of the loads in flight
+	if (TableLoads.IsEmpty() && TablesToSync.Num())
+	{
+		TableLoadStartTime = FPlatformTime::Seconds();
+	}
+
+	for (const FSoftObjectPath& TablePath : TablesToSync)
 	{
-		if (Table.IsValid())
+		TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(TablePath, FStreamableDelegate::CreateRaw(this, &FFPEditorUtilitiesModule::HandleTableLoaded, TablePath));
+		if (Handle.IsValid() && !Handle->HasLoadCompleted())
 		{
-			Table->OnDataTableChanged().RemoveAll(this);
+			TableLoads.Add(TablePath, Handle);
 		}
 	}
+}
 
-	BoundTables.Empty();
+void FFPEditorUtilitiesModule::UnbindTable(const FSoftObjectPath& TablePath)
+{
+	TSharedPtr<FStreamableHandle> Handle;
+	if (TableLoads.RemoveAndCopyValue(TablePath, Handle) && Handle.IsValid())
+	{
+		Handle->CancelHandle();
+	}
 
-	// try import tags when a data table is changed
-	for (auto& TablesUsingGameplayTag : UFPEditorUtilitySettings::Get().TablesUsingGameplayTags)
+	for (auto It = BoundTables.CreateIterator(); It; ++It)
 	{
-		if (auto Table = TablesUsingGameplayTag.DataTable.LoadSynchronous())
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+		else if (FSoftObjectPath(It->Key.Get()) == TablePath)
 		{
-			ReadTableFiles(Table);
-			Table->OnDataTableChanged().AddRaw(this, &FFPEditorUtilitiesModule::ReadTableFiles, Table);
-			BoundTables.Add(Table);
+			It->Key->OnDataTableChanged().RemoveAll(this);
+			It.RemoveCurrent();
 		}
 	}
 }
 
-void FFPEditorUtilitiesModule::RegisterGameCategory()
+void FFPEditorUtilitiesModule::HandleTableLoaded(FSoftObjectPath TablePath)
 {
-	FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	TableLoads.Remove(TablePath);
 
-	FString ProjName = FString(FApp::GetProjectName());
-	static const FString Prefix = FString::Printf(TEXT("/Script/%s"), *ProjName);
-
-	for (const auto* const Class : TObjectRange<UClass>())
+	if (UDataTable* Table = Cast<UDataTable>(TablePath.ResolveObject()))
 	{
-		if (!Class->GetClassPathName().ToString().StartsWith(Prefix)) 
-		{ 
-			continue; 
-		}
+		const double SyncStartTime = FPlatformTime::Seconds();
+		ReadTableFiles(Table);
 
-		const TSharedRef<FPropertySection> Section = PropertyModule.FindOrCreateSection(
-			Class->GetFName(),
-			TEXT("MyProject"),
-			INVTEXT("🍩Project")
-		);
+		// the editor utils notifications miss rows added or removed from code, which only broadcast OnDataTableChanged
+		Table->OnDataTableChanged().RemoveAll(this);
+		Table->OnDataTableChanged().AddRaw(this, &FFPEditorUtilitiesModule::HandleTableChanged, Table);
+
+		UE_LOG(LogTemp, Log, TEXT("Bound tag table %s: loaded after %.1fms, synced in %.1fms"),
+			*Table->GetName(), (SyncStartTime - TableLoadStartTime) * 1000.0, (FPlatformTime::Seconds() - SyncStartTime) * 1000.0);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to load tag table %s"), *TablePath.ToString());
+	}
+}
 
-		Section->AddCategory(TEXT("Default"));
-		Section->AddCategory(Class->GetFName());
+void FFPEditorUtilitiesModule::CancelTableLoads()
+{
+	for (const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& TableLoad : TableLoads)
+	{
+		if (TableLoad.Value.IsValid())
+		{
+			TableLoad.Value->CancelHandle();
+		}
 	}
+
+	TableLoads.Empty();
 }
 
 #undef LOCTEXT_NAMESPACE
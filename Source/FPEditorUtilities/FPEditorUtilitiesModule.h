@@ -1,10 +1,26 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "DataTableEditorUtils.h"
+#include "Engine/StreamableManager.h"
 
+class FFPClassSections;
 class FFPObjectTableAssetTypeActions;
+class FFPTagFileWatcher;
+class FFPTableExportServer;
+class FTransactionObjectEvent;
 
-class FFPEditorUtilitiesModule final : public IModuleInterface
+/** A table whose new rows are added to its tag source */
+struct FFPBoundTagTable
+{
+	/** Row names which were already checked for new tags */
+	TSet<FName> SyncedRows;
+
+	/** Rows at the last sync, a change which keeps the count hasn't added or removed any */
+	int32 NumRows = 0;
+};
+
+class FFPEditorUtilitiesModule final : public IModuleInterface, public FDataTableEditorUtils::INotifyOnDataTableChanged
 {
 public:
 	/** IModuleInterface implementation */
@@ -12,18 +28,35 @@ public:
 	virtual void ShutdownModule() override;
 
 	void OnPostEngineInit();
-
-	void CheckTagFiles();
+	void RegisterToolsMenu();
 
 	void ReadTableFiles(UDataTable* Table);
 	void BindTables();
+	void UnbindTable(const FSoftObjectPath& TablePath);
+	void HandleTableLoaded(FSoftObjectPath TablePath);
+	void CancelTableLoads();
+
+	void HandleTableChanged(UDataTable* Table);
+	void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+	void HandleAssetReimport(UObject* Asset);
 
-	void RegisterGameCategory();
+	/** FDataTableEditorUtils::INotifyOnDataTableChanged */
+	virtual void PreChange(const UDataTable* Changed, FDataTableEditorUtils::EDataTableChangeInfo Info) override {}
+	virtual void PostChange(const UDataTable* Changed, FDataTableEditorUtils::EDataTableChangeInfo Info) override;
 
 private:
 	TSharedPtr<FFPObjectTableAssetTypeActions> ObjectTableActions;
+	TSharedPtr<FFPTableExportServer> ExportServer;
+
+	TUniquePtr<FFPTagFileWatcher> TagFileWatcher;
+	TUniquePtr<FFPClassSections> ClassSections;
+
+	TMap<TWeakObjectPtr<UDataTable>, FFPBoundTagTable> BoundTables;
 
-	FTimerHandle UpdateTimer;
+	/** The tag source (INI file name) of each bound table, rebuilt when the settings change */
+	TMap<FSoftObjectPath, FName> TableTagSources;
 
-	TArray<TWeakObjectPtr<UDataTable>> BoundTables;
+	FStreamableManager StreamableManager;
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> TableLoads;
+	double TableLoadStartTime = 0.0;
 };
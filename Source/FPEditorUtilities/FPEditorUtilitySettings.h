@@ -6,6 +6,17 @@
 #include "UObject/Object.h"
 #include "FPEditorUtilitySettings.generated.h"
 
+UENUM()
+enum class EFPMergeConflictPolicy : uint8
+{
+	/** A row in a later source replaces the same row from an earlier source */
+	LastSourceWins,
+	/** The first source with a row keeps it */
+	FirstSourceWins,
+	/** The import fails when more than one source has the same row */
+	Fail,
+};
+
 USTRUCT(BlueprintType)
 struct FDataTableTags
 {
@@ -27,6 +38,38 @@ public:
 	UPROPERTY(Config, EditAnywhere)
 	TArray<FDataTableTags> TablesUsingGameplayTags;
 
+	/** How a DataTable importing from several sources resolves rows which are in more than one of them */
+	UPROPERTY(Config, EditAnywhere, Category = "Import")
+	EFPMergeConflictPolicy MergeConflictPolicy = EFPMergeConflictPolicy::LastSourceWins;
+
+	/**
+	 * Reimporting a DataTable from a Google Sheets CSV url fetches the rows in slices of about this many rows at once,
+	 * based on the current number of rows. 0 always fetches the sheet in one request
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Import", meta = (ClampMin = 0))
+	int32 RowsPerSlice = 5000;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Import", meta = (ClampMin = 1, EditCondition = "RowsPerSlice > 0"))
+	int32 MaxSlices = 8;
+
+	/** URL imports send at most this many requests to one host at once, the rest wait in a queue */
+	UPROPERTY(Config, EditAnywhere, Category = "Import", meta = (ClampMin = 1))
+	int32 MaxRequestsPerHost = 4;
+
+	/** Serve table exports to this machine only, from http://127.0.0.1:<ExportServerPort>/fpexport?asset=/Game/Path/Table&format=csv|jsonl */
+	UPROPERTY(Config, EditAnywhere, Category = "Export")
+	bool bEnableExportServer = false;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Export", meta = (EditCondition = "bEnableExportServer"))
+	int32 ExportServerPort = 8765;
+
+	/**
+	 * Milliseconds of plugin startup work per frame. What the first frame needs runs at once, the rest is spread over
+	 * the following frames. FP.StartupReport logs the cost of each step
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Startup", meta = (ClampMin = 0))
+	float StartupBudgetMs = 5.0f;
+
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 
 	FSimpleMulticastDelegate OnTablesChanged;
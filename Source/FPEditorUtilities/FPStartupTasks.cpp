@@ -0,0 +1,107 @@
+#include "FPStartupTasks.h"
+
+#include "FPEditorUtilitySettings.h"
+#include "Misc/LazySingleton.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+static FAutoConsoleCommand StartupReportCommand(
+	TEXT("FP.StartupReport"),
+	TEXT("Log how long each FPEditorUtilities startup step took"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FFPStartupTasks::Get().LogReport();
+	}));
+
+FFPStartupTasks& FFPStartupTasks::Get()
+{
+	return TLazySingleton<FFPStartupTasks>::Get();
+}
+
+void FFPStartupTasks::TearDown()
+{
+	return TLazySingleton<FFPStartupTasks>::TearDown();
+}
+
+FFPStartupTasks::~FFPStartupTasks()
+{
+	// the deferred tasks may point at a module which is shutting down
+	FTSTicker::GetCoreTicker().RemoveTicker(DeferredTicker);
+}
+
+void FFPStartupTasks::RunNow(const TCHAR* Name, TFunctionRef<void()> Task)
+{
+	RunStep(Name, Task, false);
+}
+
+void FFPStartupTasks::Defer(const TCHAR* Name, TFunction<void()> Task)
+{
+	DeferredTasks.Add({ Name, MoveTemp(Task) });
+
+	if (!DeferredTicker.IsValid())
+	{
+		DeferredTicker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFPStartupTasks::RunDeferred));
+	}
+}
+
+void FFPStartupTasks::RunStep(const TCHAR* Name, TFunctionRef<void()> Task, bool bDeferred)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(Name);
+
+	const double StartTime = FPlatformTime::Seconds();
+	Task();
+	Steps.Add({ Name, (FPlatformTime::Seconds() - StartTime) * 1000.0, bDeferred });
+}
+
+bool FFPStartupTasks::RunDeferred(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FFPStartupTasks::RunDeferred);
+
+	const double BudgetMs = UFPEditorUtilitySettings::Get().StartupBudgetMs;
+	const double FrameStart = FPlatformTime::Seconds();
+	++NumDeferredFrames;
+
+	// at least one task a frame, so a budget smaller than a task still finishes
+	int32 NumRun = 0;
+	while (DeferredTasks.Num() && (NumRun == 0 || (FPlatformTime::Seconds() - FrameStart) * 1000.0 < BudgetMs))
+	{
+		// taken out first, a task may defer another
+		FDeferredTask Deferred = MoveTemp(DeferredTasks[0]);
+		DeferredTasks.RemoveAt(0);
+
+		RunStep(Deferred.Name, Deferred.Task, true);
+		++NumRun;
+	}
+
+	if (DeferredTasks.Num())
+	{
+		return true;
+	}
+
+	DeferredTicker.Reset();
+	LogReport();
+	return false;
+}
+
+void FFPStartupTasks::LogReport() const
+{
+	double FirstFrameMs = 0.0;
+	double DeferredMs = 0.0;
+	for (const FStep& Step : Steps)
+	{
+		(Step.bDeferred ? DeferredMs : FirstFrameMs) += Step.Ms;
+	}
+
+	const double BudgetMs = UFPEditorUtilitySettings::Get().StartupBudgetMs;
+	UE_LOG(LogTemp, Log, TEXT("FPEditorUtilities startup: %.1fms before the first frame (budget %.1fms), %.1fms deferred over %d frames%s"),
+		FirstFrameMs, BudgetMs, DeferredMs, NumDeferredFrames, DeferredTasks.Num() ? TEXT(", still running") : TEXT(""));
+
+	for (const FStep& Step : Steps)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %-28s %7.2fms%s"), Step.Name, Step.Ms, Step.bDeferred ? TEXT(" (deferred)") : TEXT(""));
+	}
+
+	if (FirstFrameMs > BudgetMs)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FPEditorUtilities took %.1fms before the first frame, over the %.1fms startup budget"), FirstFrameMs, BudgetMs);
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Runs and times the plugin's startup steps. Steps the first frame doesn't need are deferred and run a few per
+ * frame afterwards, as many as fit in the startup budget from the plugin settings
+ */
+class FFPStartupTasks
+{
+public:
+	static FFPStartupTasks& Get();
+	static void TearDown();
+
+	~FFPStartupTasks();
+
+	void RunNow(const TCHAR* Name, TFunctionRef<void()> Task);
+	void Defer(const TCHAR* Name, TFunction<void()> Task);
+
+	void LogReport() const;
+
+private:
+	struct FStep
+	{
+		const TCHAR* Name = nullptr;
+		double Ms = 0.0;
+		bool bDeferred = false;
+	};
+
+	struct FDeferredTask
+	{
+		const TCHAR* Name = nullptr;
+		TFunction<void()> Task;
+	};
+
+	void RunStep(const TCHAR* Name, TFunctionRef<void()> Task, bool bDeferred);
+	bool RunDeferred(float DeltaTime);
+
+	TArray<FStep> Steps;
+	TArray<FDeferredTask> DeferredTasks;
+	int32 NumDeferredFrames = 0;
+	FTSTicker::FDelegateHandle DeferredTicker;
+};
@@ -0,0 +1,117 @@
+#include "FPTagFileWatcher.h"
+
+#include "DirectoryWatcherModule.h"
+#include "FPTagSources.h"
+#include "GameplayTagsManager.h"
+
+static FString GetFullFilename(const FString& Filename)
+{
+	FString FullFilename = FPaths::ConvertRelativePathToFull(Filename);
+	FPaths::NormalizeFilename(FullFilename);
+	return FullFilename;
+}
+
+FFPTagFileWatcher::~FFPTagFileWatcher()
+{
+	Stop();
+}
+
+void FFPTagFileWatcher::Start()
+{
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+	if (!DirectoryWatcher)
+	{
+		return;
+	}
+
+	// the project tag folder too, tag lists added later are created there
+	TSet<FString> Directories;
+	Directories.Add(GetFullFilename(FPaths::ProjectConfigDir() / TEXT("Tags")));
+	for (const FGameplayTagSource* TagSource : FPTagSources::GetINISources())
+	{
+		Directories.Add(FPaths::GetPath(GetFullFilename(TagSource->GetConfigFileName())));
+	}
+
+	for (const FString& Directory : Directories)
+	{
+		if (WatchedDirectories.Contains(Directory) || !IFileManager::Get().DirectoryExists(*Directory))
+		{
+			continue;
+		}
+
+		FDelegateHandle Handle;
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory, IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FFPTagFileWatcher::HandleDirectoryChanged), Handle);
+		WatchedDirectories.Add(Directory, Handle);
+	}
+}
+
+void FFPTagFileWatcher::Stop()
+{
+	if (ReloadTicker.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReloadTicker);
+		ReloadTicker.Reset();
+	}
+
+	ChangedFiles.Reset();
+
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+		{
+			for (const TPair<FString, FDelegateHandle>& Directory : WatchedDirectories)
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Directory.Key, Directory.Value);
+			}
+		}
+	}
+
+	WatchedDirectories.Reset();
+}
+
+void FFPTagFileWatcher::HandleDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+	for (const FFileChangeData& Change : Changes)
+	{
+		if (FPaths::GetExtension(Change.Filename) == TEXT("ini"))
+		{
+			ChangedFiles.Add(GetFullFilename(Change.Filename));
+		}
+	}
+
+	if (ChangedFiles.IsEmpty())
+	{
+		return;
+	}
+
+	LastChangeTime = FPlatformTime::Seconds();
+	if (!ReloadTicker.IsValid())
+	{
+		ReloadTicker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFPTagFileWatcher::ReloadChangedFiles), 0.1f);
+	}
+}
+
+bool FFPTagFileWatcher::ReloadChangedFiles(float DeltaTime)
+{
+	// wait until the writes have settled
+	if (FPlatformTime::Seconds() - LastChangeTime < DebounceSeconds)
+	{
+		return true;
+	}
+
+	TArray<FString> TagFiles;
+	for (const FGameplayTagSource* TagSource : FPTagSources::GetINISources())
+	{
+		const FString ConfigFileName = TagSource->GetConfigFileName();
+		if (ChangedFiles.Contains(GetFullFilename(ConfigFileName)))
+		{
+			TagFiles.Add(ConfigFileName);
+		}
+	}
+
+	ChangedFiles.Reset();
+	ReloadTicker.Reset();
+
+	FPTagSources::ReloadFiles(TagFiles);
+	return false;
+}
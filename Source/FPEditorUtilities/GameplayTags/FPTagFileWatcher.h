@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "IDirectoryWatcher.h"
+
+/**
+ * Reloads tag INIs when they change on disk. The directories of the tag sources are watched, a burst of writes is
+ * collected until the files have been quiet for a moment, then only the changed tag files are reloaded
+ */
+class FFPTagFileWatcher
+{
+public:
+	~FFPTagFileWatcher();
+
+	void Start();
+	void Stop();
+
+private:
+	void HandleDirectoryChanged(const TArray<FFileChangeData>& Changes);
+	bool ReloadChangedFiles(float DeltaTime);
+
+	static constexpr double DebounceSeconds = 0.5;
+
+	TMap<FString, FDelegateHandle> WatchedDirectories;
+	TSet<FString> ChangedFiles;
+	double LastChangeTime = 0.0;
+	FTSTicker::FDelegateHandle ReloadTicker;
+};
@@ -0,0 +1,246 @@
+#include "FPTagSources.h"
+
+#include "GameplayTagsEditorModule.h"
+#include "GameplayTagsManager.h"
+#include "GameplayTagsSettings.h"
+#include "ISourceControlModule.h"
+#include "SourceControlHelpers.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+namespace FPTagSources
+{
+	static void MakeWritable(const FString& ConfigFileName)
+	{
+		if (ISourceControlModule::Get().IsEnabled())
+		{
+			USourceControlHelpers::CheckOutOrAddFile(ConfigFileName);
+		}
+		else if (IFileManager::Get().FileExists(*ConfigFileName))
+		{
+			FPlatformFileManager::Get().GetPlatformFile().SetReadOnly(*ConfigFileName, false);
+		}
+	}
+
+	/** Tag to comment (and restricted flags) of a source, what a reload is compared against */
+	static TMap<FName, FString> GetSourceRows(const FGameplayTagSource& TagSource)
+	{
+		TMap<FName, FString> Rows;
+		if (TagSource.SourceTagList)
+		{
+			for (const FGameplayTagTableRow& Row : TagSource.SourceTagList->GameplayTagList)
+			{
+				Rows.Add(Row.Tag, Row.DevComment);
+			}
+		}
+
+		if (TagSource.SourceRestrictedTagList)
+		{
+			for (const FRestrictedGameplayTagTableRow& Row : TagSource.SourceRestrictedTagList->RestrictedGameplayTagList)
+			{
+				Rows.Add(Row.Tag, Row.DevComment + (Row.bAllowNonRestrictedChildren ? TEXT(" (allows children)") : TEXT("")));
+			}
+		}
+
+		return Rows;
+	}
+
+	static TArray<TPair<FName, FName>> GetRedirects()
+	{
+		TArray<TPair<FName, FName>> Redirects;
+		for (const FGameplayTagRedirect& Redirect : GetDefault<UGameplayTagsSettings>()->GameplayTagRedirects)
+		{
+			Redirects.Emplace(Redirect.OldTagName, Redirect.NewTagName);
+		}
+		return Redirects;
+	}
+
+	static void ReloadSource(const FGameplayTagSource& TagSource, const FString& ConfigFileName)
+	{
+		if (TagSource.SourceTagList)
+		{
+			TagSource.SourceTagList->LoadConfig(TagSource.SourceTagList->GetClass(), *ConfigFileName);
+		}
+
+		if (TagSource.SourceRestrictedTagList)
+		{
+			TagSource.SourceRestrictedTagList->LoadConfig(TagSource.SourceRestrictedTagList->GetClass(), *ConfigFileName);
+		}
+	}
+}
+
+TArray<const FGameplayTagSource*> FPTagSources::GetINISources()
+{
+	TArray<const FGameplayTagSource*> AllSources;
+	UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::DefaultTagList, AllSources);
+	UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::RestrictedTagList, AllSources);
+	UGameplayTagsManager::Get().FindTagSourcesWithType(EGameplayTagSourceType::TagList, AllSources);
+	return AllSources;
+}
+
+void FPTagSources::ReloadFiles(const TArray<FString>& ConfigFileNames)
+{
+	if (ConfigFileNames.IsEmpty())
+	{
+		return;
+	}
+
+	const TArray<const FGameplayTagSource*> AllSources = GetINISources();
+	const TArray<TPair<FName, FName>> OldRedirects = GetRedirects();
+
+	bool bChanged = false;
+	for (const FString& ConfigFileName : ConfigFileNames)
+	{
+		GConfig->LoadFile(ConfigFileName);
+
+		const FGameplayTagSource* const* TagSource = AllSources.FindByPredicate([&ConfigFileName](const FGameplayTagSource* Source)
+		{
+			return FPaths::IsSamePath(Source->GetConfigFileName(), ConfigFileName);
+		});
+
+		if (!TagSource)
+		{
+			// not a file we can compare, let the refresh sort it out
+			bChanged = true;
+			continue;
+		}
+
+		const TMap<FName, FString> OldRows = GetSourceRows(**TagSource);
+		ReloadSource(**TagSource, ConfigFileName);
+		const TMap<FName, FString> NewRows = GetSourceRows(**TagSource);
+
+		int32 NumAdded = 0;
+		int32 NumChanged = 0;
+		for (const TPair<FName, FString>& Row : NewRows)
+		{
+			const FString* OldComment = OldRows.Find(Row.Key);
+			NumAdded += OldComment ? 0 : 1;
+			NumChanged += OldComment && *OldComment != Row.Value ? 1 : 0;
+		}
+
+		const int32 NumRemoved = OldRows.Num() - (NewRows.Num() - NumAdded);
+		if (NumAdded + NumRemoved + NumChanged == 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("%s: no tags changed"), *ConfigFileName);
+			continue;
+		}
+
+		bChanged = true;
+		UE_LOG(LogTemp, Log, TEXT("%s: %d tags added, %d removed, %d changed"), *ConfigFileName, NumAdded, NumRemoved, NumChanged);
+
+		FText Msg = FText::FromString(FString::Printf(TEXT("Reloaded %s"), *ConfigFileName));
+		FNotificationInfo Notification(Msg);
+		Notification.ExpireDuration = 5.0f;
+		FSlateNotificationManager::Get().AddNotification(Notification);
+	}
+
+	// redirects live in the default tag list, GetDefault reflects the reload above
+	bChanged |= GetRedirects() != OldRedirects;
+
+	// the tag manager only rebuilds its tree as a whole, so at least skip it when the files had nothing new
+	if (bChanged)
+	{
+		UGameplayTagsManager::Get().EditorRefreshGameplayTagTree();
+	}
+}
+
+TArray<FString> FPTagSources::AddTags(FName TagSourceName, const TArray<FString>& Tags, const FString& DevComment)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+
+	TSet<FName> Seen;
+	TArray<FString> NewTags;
+	for (const FString& Tag : Tags)
+	{
+		const FName TagName(Tag);
+		if (Seen.Contains(TagName) || Manager.IsDictionaryTag(TagName))
+		{
+			continue;
+		}
+
+		Seen.Add(TagName);
+
+		FText Error;
+		if (!Manager.IsValidGameplayTagString(Tag, &Error))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Skipped invalid tag %s: %s"), *Tag, *Error.ToString());
+			continue;
+		}
+
+		NewTags.Add(Tag);
+	}
+
+	if (NewTags.IsEmpty())
+	{
+		return {};
+	}
+
+	FGameplayTagSource* TagSource = Manager.FindOrAddTagSource(TagSourceName, EGameplayTagSourceType::TagList);
+	if (!TagSource)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to find or add the tag source %s"), *TagSourceName.ToString());
+		return {};
+	}
+
+	// the default source (DefaultGameplayTags.ini) is backed by the tag settings, tag list INIs (Config/Tags) by their own list
+	UGameplayTagsList* TagList = nullptr;
+	FString ConfigFileName;
+	if (TagSource->SourceType == EGameplayTagSourceType::DefaultTagList)
+	{
+		TagList = GetMutableDefault<UGameplayTagsSettings>();
+		ConfigFileName = TagList->GetDefaultConfigFilename();
+	}
+	else if (TagSource->SourceType == EGameplayTagSourceType::TagList && TagSource->SourceTagList)
+	{
+		TagList = TagSource->SourceTagList;
+		ConfigFileName = TagSource->GetConfigFileName();
+	}
+
+	// anything else (e.g. a restricted tag list) goes through the editor module a tag at a time
+	if (!TagList)
+	{
+		TArray<FString> AddedTags;
+		const bool bIsRestricted = TagSource->SourceType == EGameplayTagSourceType::RestrictedTagList;
+		for (const FString& Tag : NewTags)
+		{
+			if (IGameplayTagsEditorModule::Get().AddNewGameplayTagToINI(Tag, DevComment, TagSourceName, bIsRestricted))
+			{
+				AddedTags.Add(Tag);
+			}
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Added %d tags to %s in %.2fs"), AddedTags.Num(), *TagSourceName.ToString(), FPlatformTime::Seconds() - StartTime);
+		return AddedTags;
+	}
+
+	const TArray<FGameplayTagTableRow> OldRows = TagList->GameplayTagList;
+	for (const FString& Tag : NewTags)
+	{
+		TagList->GameplayTagList.Emplace(FName(Tag), DevComment);
+	}
+
+	TagList->SortTags();
+
+	// the same as IGameplayTagsEditorModule::AddNewGameplayTagToINI, which keeps the rest of the file, but once for all the tags
+	MakeWritable(ConfigFileName);
+	if (!TagList->TryUpdateDefaultConfigFile(ConfigFileName))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write %s"), *ConfigFileName);
+		TagList->GameplayTagList = OldRows;
+		return {};
+	}
+
+	GConfig->LoadFile(ConfigFileName);
+	Manager.EditorRefreshGameplayTagTree();
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogTemp, Log, TEXT("Added %d tags to %s in %.2fs"), NewTags.Num(), *ConfigFileName, Seconds);
+
+	FNotificationInfo Notification(FText::Format(INVTEXT("Added {0} tags to {1}"), NewTags.Num(), FText::FromName(TagSourceName)));
+	Notification.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Notification);
+
+	return NewTags;
+}
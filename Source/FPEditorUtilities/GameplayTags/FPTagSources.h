@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGameplayTagSource;
+
+namespace FPTagSources
+{
+	/** The default, restricted and tag list sources, which are backed by INI files */
+	TArray<const FGameplayTagSource*> GetINISources();
+
+	/**
+	 * Reload the INIs into the config cache and their tag sources, comparing the tags of each source before and after.
+	 * The tag tree is refreshed once if any tag, restricted tag or redirect changed, and not at all otherwise.
+	 */
+	void ReloadFiles(const TArray<FString>& ConfigFileNames);
+
+	/**
+	 * Add the tags which aren't in the dictionary yet to DefaultGameplayTags.ini or a tag list INI (Config/Tags) in one go:
+	 * the tag list section is written once through the config system and the tag tree is refreshed once. Other sources,
+	 * such as restricted tag lists, add the tags one at a time through the gameplay tags editor. Returns the tags which were added.
+	 */
+	TArray<FString> AddTags(FName TagSourceName, const TArray<FString>& Tags, const FString& DevComment = FString());
+}
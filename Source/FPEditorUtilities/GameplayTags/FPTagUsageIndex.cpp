@@ -0,0 +1,304 @@
+#include "FPTagUsageIndex.h"
+
+#include "GameplayTagContainer.h"
+#include "GameplayTagsManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/LazySingleton.h"
+#include "UObject/UObjectIterator.h"
+
+namespace FPTagUsageIndex
+{
+	static void CollectTags(const UStruct* Struct, const void* Data, TSet<FName>& OutTags);
+
+	static void CollectPropertyTags(const FProperty* Property, const void* Value, TSet<FName>& OutTags)
+	{
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (StructProperty->Struct == FGameplayTag::StaticStruct())
+			{
+				const FGameplayTag& Tag = *static_cast<const FGameplayTag*>(Value);
+				if (Tag.IsValid())
+				{
+					OutTags.Add(Tag.GetTagName());
+				}
+			}
+			else if (StructProperty->Struct == FGameplayTagContainer::StaticStruct())
+			{
+				for (const FGameplayTag& Tag : *static_cast<const FGameplayTagContainer*>(Value))
+				{
+					OutTags.Add(Tag.GetTagName());
+				}
+			}
+			else
+			{
+				CollectTags(StructProperty->Struct, Value, OutTags);
+			}
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper Helper(ArrayProperty, Value);
+			for (int32 Index = 0; Index < Helper.Num(); ++Index)
+			{
+				CollectPropertyTags(ArrayProperty->Inner, Helper.GetRawPtr(Index), OutTags);
+			}
+		}
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			FScriptSetHelper Helper(SetProperty, Value);
+			for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+			{
+				if (Helper.IsValidIndex(Index))
+				{
+					CollectPropertyTags(SetProperty->ElementProp, Helper.GetElementPtr(Index), OutTags);
+				}
+			}
+		}
+		else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			FScriptMapHelper Helper(MapProperty, Value);
+			for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+			{
+				if (Helper.IsValidIndex(Index))
+				{
+					CollectPropertyTags(MapProperty->KeyProp, Helper.GetKeyPtr(Index), OutTags);
+					CollectPropertyTags(MapProperty->ValueProp, Helper.GetValuePtr(Index), OutTags);
+				}
+			}
+		}
+	}
+
+	static void CollectTags(const UStruct* Struct, const void* Data, TSet<FName>& OutTags)
+	{
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+			{
+				CollectPropertyTags(*It, It->ContainerPtrToValuePtr<void>(Data, Index), OutTags);
+			}
+		}
+	}
+
+	static void AddTagAndChildren(FName Tag, bool bIncludeChildren, TArray<FName>& OutTags)
+	{
+		OutTags.Add(Tag);
+		if (bIncludeChildren)
+		{
+			const FGameplayTag GameplayTag = FGameplayTag::RequestGameplayTag(Tag, false);
+			for (const FGameplayTag& Child : UGameplayTagsManager::Get().RequestGameplayTagChildren(GameplayTag))
+			{
+				OutTags.Add(Child.GetTagName());
+			}
+		}
+	}
+}
+
+static FAutoConsoleCommand TagUsageCommand(
+	TEXT("FP.TagUsage"),
+	TEXT("Log the tables, rows and assets using a gameplay tag. FP.TagUsage <Tag> [children]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num())
+		{
+			FFPTagUsageIndex::Get().LogUsage(FName(Args[0]), Args.Num() > 1 && Args[1] == TEXT("children"));
+		}
+	}));
+
+static FAutoConsoleCommand UnusedTagsCommand(
+	TEXT("FP.UnusedTags"),
+	TEXT("Log the tags of a tag source (e.g. MyTags.ini) which no loaded table row or saved asset uses. FP.UnusedTags <TagSource>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num())
+		{
+			FFPTagUsageIndex::Get().LogUnusedTags(FName(Args[0]));
+		}
+	}));
+
+FFPTagUsageIndex& FFPTagUsageIndex::Get()
+{
+	return TLazySingleton<FFPTagUsageIndex>::Get();
+}
+
+void FFPTagUsageIndex::TearDown()
+{
+	return TLazySingleton<FFPTagUsageIndex>::TearDown();
+}
+
+FFPTagUsageIndex::~FFPTagUsageIndex()
+{
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+}
+
+void FFPTagUsageIndex::Start()
+{
+	if (AssetLoadedHandle.IsValid())
+	{
+		return;
+	}
+
+	for (TObjectIterator<UDataTable> It; It; ++It)
+	{
+		if (!It->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			IndexTable(*It);
+		}
+	}
+
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FFPTagUsageIndex::HandleAssetLoaded);
+}
+
+void FFPTagUsageIndex::PostChange(const UDataTable* Changed, FDataTableEditorUtils::EDataTableChangeInfo Info)
+{
+	if (AssetLoadedHandle.IsValid() && Changed)
+	{
+		IndexTable(Changed);
+	}
+}
+
+void FFPTagUsageIndex::HandleAssetLoaded(UObject* Asset)
+{
+	if (const UDataTable* Table = Cast<UDataTable>(Asset))
+	{
+		IndexTable(Table);
+	}
+}
+
+void FFPTagUsageIndex::IndexTable(const UDataTable* Table)
+{
+	RemoveTable(Table);
+
+	const UScriptStruct* RowStruct = Table->GetRowStruct();
+	UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+
+	TSet<FName>& Tags = TableTags.Add(Table);
+	TSet<FName> RowTags;
+	for (const TPair<FName, uint8*>& Row : Table->GetRowMap())
+	{
+		// tag tables generate a tag per row
+		if (Manager.IsDictionaryTag(Row.Key))
+		{
+			TagRows.FindOrAdd(Row.Key).Add({ const_cast<UDataTable*>(Table), Row.Key, true });
+			Tags.Add(Row.Key);
+		}
+
+		if (!RowStruct)
+		{
+			continue;
+		}
+
+		RowTags.Reset();
+		FPTagUsageIndex::CollectTags(RowStruct, Row.Value, RowTags);
+		// the set holds each tag once per row, so the row is added without searching the tag's rows
+		for (FName Tag : RowTags)
+		{
+			TagRows.FindOrAdd(Tag).Add({ const_cast<UDataTable*>(Table), Row.Key, false });
+			Tags.Add(Tag);
+		}
+	}
+
+	if (Tags.IsEmpty())
+	{
+		TableTags.Remove(Table);
+	}
+}
+
+void FFPTagUsageIndex::RemoveTable(const UDataTable* Table)
+{
+	TSet<FName> Tags;
+	if (!TableTags.RemoveAndCopyValue(Table, Tags))
+	{
+		return;
+	}
+
+	for (FName Tag : Tags)
+	{
+		if (TArray<FFPTagRowRef>* Rows = TagRows.Find(Tag))
+		{
+			Rows->RemoveAll([Table](const FFPTagRowRef& Row) { return !Row.Table.IsValid() || Row.Table == Table; });
+			if (Rows->IsEmpty())
+			{
+				TagRows.Remove(Tag);
+			}
+		}
+	}
+}
+
+TArray<FFPTagRowRef> FFPTagUsageIndex::FindRows(FName Tag) const
+{
+	TArray<FFPTagRowRef> Rows;
+	if (const TArray<FFPTagRowRef>* Found = TagRows.Find(Tag))
+	{
+		for (const FFPTagRowRef& Row : *Found)
+		{
+			if (Row.Table.IsValid())
+			{
+				Rows.Add(Row);
+			}
+		}
+	}
+	return Rows;
+}
+
+TArray<FName> FFPTagUsageIndex::FindPackages(FName Tag) const
+{
+	// FGameplayTag marks its name as searchable when saved, the asset registry keeps those references up to date
+	TArray<FAssetIdentifier> Referencers;
+	IAssetRegistry::GetChecked().GetReferencers(FAssetIdentifier(FGameplayTag::StaticStruct(), Tag), Referencers, UE::AssetRegistry::EDependencyCategory::SearchableName);
+
+	TArray<FName> Packages;
+	for (const FAssetIdentifier& Referencer : Referencers)
+	{
+		if (!Referencer.PackageName.IsNone())
+		{
+			Packages.AddUnique(Referencer.PackageName);
+		}
+	}
+	return Packages;
+}
+
+void FFPTagUsageIndex::LogUsage(FName Tag, bool bIncludeChildren) const
+{
+	TArray<FName> Tags;
+	FPTagUsageIndex::AddTagAndChildren(Tag, bIncludeChildren, Tags);
+
+	for (FName QueryTag : Tags)
+	{
+		const TArray<FFPTagRowRef> Rows = FindRows(QueryTag);
+		const TArray<FName> Packages = FindPackages(QueryTag);
+		UE_LOG(LogTemp, Log, TEXT("%s: %d rows, %d packages"), *QueryTag.ToString(), Rows.Num(), Packages.Num());
+
+		for (const FFPTagRowRef& Row : Rows)
+		{
+			UE_LOG(LogTemp, Log, TEXT("  %s.%s%s"), *Row.Table->GetPathName(), *Row.RowName.ToString(), Row.bIsRowName ? TEXT(" (row name)") : TEXT(""));
+		}
+
+		for (FName Package : Packages)
+		{
+			UE_LOG(LogTemp, Log, TEXT("  %s"), *Package.ToString());
+		}
+	}
+}
+
+void FFPTagUsageIndex::LogUnusedTags(FName TagSourceName) const
+{
+	const FGameplayTagSource* TagSource = UGameplayTagsManager::Get().FindTagSource(TagSourceName);
+	if (!TagSource || !TagSource->SourceTagList)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No tag list source named %s"), *TagSourceName.ToString());
+		return;
+	}
+
+	int32 NumUnused = 0;
+	for (const FGameplayTagTableRow& Row : TagSource->SourceTagList->GameplayTagList)
+	{
+		// generated by a tag table row is not a use
+		const bool bUsedByRow = FindRows(Row.Tag).ContainsByPredicate([](const FFPTagRowRef& Ref) { return !Ref.bIsRowName; });
+		if (!bUsedByRow && FindPackages(Row.Tag).IsEmpty())
+		{
+			UE_LOG(LogTemp, Log, TEXT("  %s"), *Row.Tag.ToString());
+			++NumUnused;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%d of %d tags in %s are unused"), NumUnused, TagSource->SourceTagList->GameplayTagList.Num(), *TagSourceName.ToString());
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DataTableEditorUtils.h"
+
+/** A row of a loaded table which uses a tag, either as a value or as its row name (tag tables) */
+struct FFPTagRowRef
+{
+	TWeakObjectPtr<UDataTable> Table;
+	FName RowName;
+	bool bIsRowName = false;
+};
+
+/**
+ * Which tables, rows and assets use a gameplay tag. Rows of loaded DataTables are indexed as tables load and change,
+ * assets come from the searchable name references the asset registry keeps for saved tags, so queries load nothing
+ */
+class FFPTagUsageIndex : public FDataTableEditorUtils::INotifyOnDataTableChanged
+{
+public:
+	static FFPTagUsageIndex& Get();
+	static void TearDown();
+
+	virtual ~FFPTagUsageIndex() override;
+
+	/** Index the loaded tables and follow tables loaded later */
+	void Start();
+
+	TArray<FFPTagRowRef> FindRows(FName Tag) const;
+
+	/** Packages saved with a reference to the tag */
+	TArray<FName> FindPackages(FName Tag) const;
+
+	void LogUsage(FName Tag, bool bIncludeChildren) const;
+
+	/** Tags of a tag source which no indexed row or saved asset uses */
+	void LogUnusedTags(FName TagSourceName) const;
+
+	/** FDataTableEditorUtils::INotifyOnDataTableChanged */
+	virtual void PreChange(const UDataTable* Changed, FDataTableEditorUtils::EDataTableChangeInfo Info) override {}
+	virtual void PostChange(const UDataTable* Changed, FDataTableEditorUtils::EDataTableChangeInfo Info) override;
+
+private:
+	void IndexTable(const UDataTable* Table);
+	void RemoveTable(const UDataTable* Table);
+	void HandleAssetLoaded(UObject* Asset);
+
+	TMap<FName, TArray<FFPTagRowRef>> TagRows;
+
+	/** The tags each table was indexed under, so it can be removed before it is indexed again */
+	TMap<TWeakObjectPtr<const UDataTable>, TSet<FName>> TableTags;
+
+	FDelegateHandle AssetLoadedHandle;
+};
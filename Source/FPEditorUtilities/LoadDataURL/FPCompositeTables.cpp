@@ -0,0 +1,462 @@
+#include "FPCompositeTables.h"
+
+#include "AssetToolsModule.h"
+#include "DataTableEditorUtils.h"
+#include "FPTableParser.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Engine/CompositeDataTable.h"
+#include "Factories/DataTableFactory.h"
+#include "UObject/UObjectIterator.h"
+
+static FName NAME_SHARD_HASH("FPShardHash");
+static FName NAME_SHARD_FIRST_ROW("FPShardFirstRow");
+static FName NAME_SHARD_COUNT("FPShardCount");
+
+// scopes held by import jobs close in whatever order the jobs finish
+static TArray<FFPCompositeRebuildScope*> GOpenRebuildScopes;
+
+FFPCompositeRebuildScope::FFPCompositeRebuildScope()
+{
+	GOpenRebuildScopes.Add(this);
+}
+
+void FFPCompositeRebuildScope::AddTable(const UDataTable* Table)
+{
+	Tables.Add(Table);
+}
+
+void FFPCompositeRebuildScope::Defer(UDataTable* Table)
+{
+	DeferredTables.AddUnique(Table);
+}
+
+FFPCompositeRebuildScope* FFPCompositeRebuildScope::Find(const UDataTable* Table)
+{
+	for (int32 Index = GOpenRebuildScopes.Num() - 1; Index >= 0; --Index)
+	{
+		if (GOpenRebuildScopes[Index]->Tables.Contains(Table))
+		{
+			return GOpenRebuildScopes[Index];
+		}
+	}
+
+	return nullptr;
+}
+
+FFPCompositeRebuildScope::~FFPCompositeRebuildScope()
+{
+	GOpenRebuildScopes.Remove(this);
+	if (DeferredTables.IsEmpty())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TSet<UDataTable*> ChangedTables;
+	for (const TWeakObjectPtr<UDataTable>& Table : DeferredTables)
+	{
+		if (UDataTable* ChangedTable = Table.Get())
+		{
+			ChangedTables.Add(ChangedTable);
+		}
+	}
+
+	DeferredTables.Reset();
+
+	// a composite is affected when one of its parents changed or is an affected composite
+	TMap<UCompositeDataTable*, TArray<UDataTable*>> CompositeParents;
+	for (TObjectIterator<UCompositeDataTable> It; It; ++It)
+	{
+		if (!It->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			CompositeParents.Add(*It, FPCompositeTables::GetParentTables(*It));
+		}
+	}
+
+	TSet<UDataTable*> Dirty = ChangedTables;
+	TSet<UCompositeDataTable*> Affected;
+	for (bool bFoundMore = true; bFoundMore; )
+	{
+		bFoundMore = false;
+		for (const TPair<UCompositeDataTable*, TArray<UDataTable*>>& Pair : CompositeParents)
+		{
+			if (!Affected.Contains(Pair.Key) && Pair.Value.ContainsByPredicate([&Dirty](UDataTable* Parent) { return Dirty.Contains(Parent); }))
+			{
+				Affected.Add(Pair.Key);
+				Dirty.Add(Pair.Key);
+				bFoundMore = true;
+			}
+		}
+	}
+
+	// parents first, so each composite is rebuilt from up to date parents
+	TArray<UCompositeDataTable*> RebuildOrder;
+	TSet<UCompositeDataTable*> Visited;
+	TFunction<void(UCompositeDataTable*)> Visit = [&](UCompositeDataTable* Composite)
+	{
+		if (Visited.Contains(Composite))
+		{
+			return;
+		}
+
+		Visited.Add(Composite);
+		for (UDataTable* Parent : CompositeParents.FindChecked(Composite))
+		{
+			UCompositeDataTable* ParentComposite = Cast<UCompositeDataTable>(Parent);
+			if (ParentComposite && Affected.Contains(ParentComposite))
+			{
+				Visit(ParentComposite);
+			}
+		}
+
+		RebuildOrder.Add(Composite);
+	};
+
+	for (UCompositeDataTable* Composite : Affected)
+	{
+		Visit(Composite);
+	}
+
+	// the composites rebind to their parents when they are rebuilt
+	for (UCompositeDataTable* Composite : RebuildOrder)
+	{
+		for (UDataTable* Parent : CompositeParents.FindChecked(Composite))
+		{
+			Parent->OnDataTableChanged().RemoveAll(Composite);
+		}
+	}
+
+	for (UDataTable* Table : ChangedTables)
+	{
+		FDataTableEditorUtils::BroadcastPostChange(Table, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+	}
+
+	for (UCompositeDataTable* Composite : RebuildOrder)
+	{
+		Composite->AppendParentTables({});
+		FDataTableEditorUtils::BroadcastPostChange(Composite, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Rebuilt %d composite tables after %d table imports in %.2fs"), RebuildOrder.Num(), ChangedTables.Num(), FPlatformTime::Seconds() - StartTime);
+}
+
+void FPCompositeTables::BroadcastRowListChanged(UDataTable* DataTable)
+{
+	if (FFPCompositeRebuildScope* Scope = FFPCompositeRebuildScope::Find(DataTable))
+	{
+		Scope->Defer(DataTable);
+		return;
+	}
+
+	FDataTableEditorUtils::BroadcastPostChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+}
+
+namespace FPCompositeTables
+{
+	struct FShard
+	{
+		TArray<FFPCSVRecord> Records;
+		uint32 Hash = 0;
+		UDataTable* Table = nullptr;
+		TUniquePtr<FFPParsedRows> ParsedRows;
+	};
+
+	static UDataTable* FindOrCreateShard(UCompositeDataTable* Composite, int32 Index)
+	{
+		const FString PackagePath = FPackageName::GetLongPackagePath(Composite->GetPackage()->GetName());
+		const FString ShardName = FString::Printf(TEXT("%s_Shard%d"), *Composite->GetName(), Index);
+		const FSoftObjectPath ShardPath(FString::Printf(TEXT("%s/%s.%s"), *PackagePath, *ShardName, *ShardName));
+
+		if (UDataTable* Loaded = Cast<UDataTable>(ShardPath.ResolveObject()))
+		{
+			return Loaded;
+		}
+
+		const FAssetData ShardAsset = IAssetRegistry::GetChecked().GetAssetByObjectPath(ShardPath);
+		if (ShardAsset.IsValid())
+		{
+			return Cast<UDataTable>(ShardAsset.GetAsset());
+		}
+
+		UDataTableFactory* Factory = NewObject<UDataTableFactory>();
+		Factory->Struct = Composite->GetRowStruct();
+		return Cast<UDataTable>(IAssetTools::Get().CreateAsset(ShardName, PackagePath, UDataTable::StaticClass(), Factory));
+	}
+
+	static uint32 GetShardHash(UDataTable* Table)
+	{
+		uint32 Hash = 0;
+		if (UPackage* Package = Table->GetPackage())
+		{
+			LexFromString(Hash, *Package->GetMetaData().GetValue(Table, NAME_SHARD_HASH));
+		}
+		return Hash;
+	}
+
+	/**
+	 * The first row name of each shard after the first, empty when the shards were never split by key range or were pinned
+	 * for another shard count. Reusing the boundaries of more shards would put every row past the last kept one in the last shard
+	 */
+	static TArray<FString> GetKeyRangeBoundaries(const UCompositeDataTable* Composite, const TArray<FShard>& Shards)
+	{
+		int32 PinnedShards = 0;
+		LexFromString(PinnedShards, *Composite->GetPackage()->GetMetaData().GetValue(Composite, NAME_SHARD_COUNT));
+		if (PinnedShards != Shards.Num())
+		{
+			return {};
+		}
+
+		TArray<FString> Boundaries;
+		for (int32 Index = 1; Index < Shards.Num(); ++Index)
+		{
+			const FString FirstRow = Shards[Index].Table->GetPackage()->GetMetaData().GetValue(Shards[Index].Table, NAME_SHARD_FIRST_ROW);
+			if (FirstRow.IsEmpty() || (Boundaries.Num() && !(Boundaries.Last() < FirstRow)))
+			{
+				return {};
+			}
+
+			Boundaries.Add(FirstRow);
+		}
+		return Boundaries;
+	}
+}
+
+TArray<UDataTable*> FPCompositeTables::GetParentTables(const UCompositeDataTable* Composite)
+{
+	TArray<UDataTable*> ParentTables;
+
+	const FArrayProperty* ArrayProperty = FindFProperty<FArrayProperty>(UCompositeDataTable::StaticClass(), TEXT("ParentTables"));
+	const FObjectPropertyBase* InnerProperty = ArrayProperty ? CastField<FObjectPropertyBase>(ArrayProperty->Inner) : nullptr;
+	if (!InnerProperty)
+	{
+		return ParentTables;
+	}
+
+	FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(Composite));
+	for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+	{
+		if (UDataTable* ParentTable = Cast<UDataTable>(InnerProperty->GetObjectPropertyValue(ArrayHelper.GetRawPtr(Index))))
+		{
+			ParentTables.Add(ParentTable);
+		}
+	}
+
+	return ParentTables;
+}
+
+void FPCompositeTables::SetParentTables(UCompositeDataTable* Composite, const TArray<UDataTable*>& ParentTables)
+{
+	const FArrayProperty* ArrayProperty = FindFProperty<FArrayProperty>(UCompositeDataTable::StaticClass(), TEXT("ParentTables"));
+	const FObjectPropertyBase* InnerProperty = ArrayProperty ? CastField<FObjectPropertyBase>(ArrayProperty->Inner) : nullptr;
+	if (!InnerProperty)
+	{
+		return;
+	}
+
+	FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(Composite));
+	ArrayHelper.Resize(ParentTables.Num());
+	for (int32 Index = 0; Index < ParentTables.Num(); ++Index)
+	{
+		InnerProperty->SetObjectPropertyValue(ArrayHelper.GetRawPtr(Index), ParentTables[Index]);
+	}
+
+	// rebinds to the new parents, unbinds the removed ones and rebuilds the rows
+	Composite->AppendParentTables({});
+}
+
+int32 FPCompositeTables::ImportShardedCSV(UCompositeDataTable* Composite, FStringView CSV, const FFPColumnMapping& Mapping, int32 NumShards, bool bByKeyRange)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	FStringView Header;
+	TArray<FFPCSVRecord> Records;
+	FPTableParser::SplitRecords(CSV, Header, Records);
+	const int32 NumRows = Records.Num();
+
+	TArray<FShard> Shards;
+	Shards.SetNum(NumShards);
+
+	for (int32 Index = 0; Index < NumShards; ++Index)
+	{
+		Shards[Index].Table = FindOrCreateShard(Composite, Index);
+		if (!Shards[Index].Table)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to create shard %d of %s"), Index, *Composite->GetName());
+			return 0;
+		}
+	}
+
+	TArray<FString> NewBoundaries;
+	if (bByKeyRange)
+	{
+		Records.Sort([](const FFPCSVRecord& A, const FFPCSVRecord& B) { return A.RowName < B.RowName; });
+
+		// the boundaries are pinned by the first import (and again when the shard count changes), so inserting a row only
+		// changes the shard it falls in
+		TArray<FString> Boundaries = GetKeyRangeBoundaries(Composite, Shards);
+		if (Boundaries.IsEmpty() && NumShards > 1 && Records.Num() >= NumShards)
+		{
+			const int32 RowsPerShard = Records.Num() / NumShards;
+			for (int32 Index = 1; Index < NumShards; ++Index)
+			{
+				Boundaries.Add(Records[Index * RowsPerShard].RowName);
+			}
+
+			// duplicate names would give an empty range, better to fall back to chunks than pin that
+			for (int32 Index = 1; Index < Boundaries.Num(); ++Index)
+			{
+				if (!(Boundaries[Index - 1] < Boundaries[Index]))
+				{
+					Boundaries.Reset();
+					break;
+				}
+			}
+
+			NewBoundaries = Boundaries;
+		}
+
+		if (Boundaries.Num())
+		{
+			for (FFPCSVRecord& Record : Records)
+			{
+				Shards[Algo::UpperBound(Boundaries, Record.RowName)].Records.Add(MoveTemp(Record));
+			}
+		}
+		else
+		{
+			const int32 RowsPerShard = FMath::DivideAndRoundUp(FMath::Max(Records.Num(), 1), NumShards);
+			for (int32 Index = 0; Index < Records.Num(); ++Index)
+			{
+				Shards[Index / RowsPerShard].Records.Add(MoveTemp(Records[Index]));
+			}
+		}
+	}
+	else
+	{
+		// crc of the lower case name so the shard of a row is stable between sessions
+		for (FFPCSVRecord& Record : Records)
+		{
+			const uint32 RowHash = FCrc::StrCrc32(*Record.RowName.ToLower());
+			Shards[RowHash % NumShards].Records.Add(MoveTemp(Record));
+		}
+	}
+
+	Records.Empty();
+
+	// a shard only needs rewriting when its rows, the header or the mapping changed
+	uint32 SharedHash = FCrc::MemCrc32(Header.GetData(), Header.Len() * sizeof(TCHAR));
+	for (const TPair<FString, FString>& Column : Mapping.Columns)
+	{
+		SharedHash = FCrc::StrCrc32(*Column.Key, FCrc::StrCrc32(*Column.Value, SharedHash));
+	}
+
+	TArray<int32> ChangedShards;
+	for (int32 Index = 0; Index < NumShards; ++Index)
+	{
+		FShard& Shard = Shards[Index];
+		Shard.Hash = SharedHash;
+		for (const FFPCSVRecord& Record : Shard.Records)
+		{
+			Shard.Hash = FCrc::MemCrc32(Record.Text.GetData(), Record.Text.Len() * sizeof(TCHAR), Shard.Hash);
+		}
+
+		if (Shard.Table->GetRowStruct() != Composite->GetRowStruct() || GetShardHash(Shard.Table) != Shard.Hash)
+		{
+			ChangedShards.Add(Index);
+		}
+	}
+
+	const EParallelForFlags ParallelFlags = FPTableParser::CanParseOffGameThread(Composite->GetRowStruct())
+		? EParallelForFlags::None
+		: EParallelForFlags::ForceSingleThread;
+
+	ParallelFor(ChangedShards.Num(), [&](int32 Index)
+	{
+		FShard& Shard = Shards[ChangedShards[Index]];
+		Shard.ParsedRows = MakeUnique<FFPParsedRows>(Composite->GetRowStruct());
+		FPTableParser::ParseRecords(Header, Shard.Records, Mapping, *Shard.ParsedRows);
+	}, ParallelFlags);
+
+	// the composite is rebuilt once for all the shards instead of once per shard, or once for the batch importing it
+	TUniquePtr<FFPCompositeRebuildScope> LocalRebuildScope;
+	FFPCompositeRebuildScope* RebuildScope = FFPCompositeRebuildScope::Find(Composite);
+	if (!RebuildScope)
+	{
+		LocalRebuildScope = MakeUnique<FFPCompositeRebuildScope>();
+		RebuildScope = LocalRebuildScope.Get();
+	}
+
+	for (int32 ShardIndex : ChangedShards)
+	{
+		FShard& Shard = Shards[ShardIndex];
+		RebuildScope->AddTable(Shard.Table);
+		if (Shard.Table->GetRowStruct() != Composite->GetRowStruct())
+		{
+			// the old rows have to be freed with the struct they were made with
+			Shard.Table->Modify();
+			Shard.Table->EmptyTable();
+			Shard.Table->RowStruct = const_cast<UScriptStruct*>(Composite->GetRowStruct());
+		}
+
+		Shard.ParsedRows->ApplyTo(Shard.Table);
+		Shard.Table->GetPackage()->GetMetaData().SetValue(Shard.Table, NAME_SHARD_HASH, *LexToString(Shard.Hash));
+		BroadcastRowListChanged(Shard.Table);
+
+		for (const FString& Problem : Shard.ParsedRows->Problems)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: %s"), *Shard.Table->GetName(), *Problem);
+		}
+	}
+
+	for (int32 Index = 1; Index <= NewBoundaries.Num(); ++Index)
+	{
+		UDataTable* Table = Shards[Index].Table;
+		Table->GetPackage()->GetMetaData().SetValue(Table, NAME_SHARD_FIRST_ROW, *NewBoundaries[Index - 1]);
+		Table->MarkPackageDirty();
+	}
+
+	if (NewBoundaries.Num())
+	{
+		Composite->GetPackage()->GetMetaData().SetValue(Composite, NAME_SHARD_COUNT, *LexToString(NumShards));
+		Composite->MarkPackageDirty();
+	}
+
+	// hook up any new shards, shards from a previous larger shard count are taken out of the composite
+	const TArray<UDataTable*> ParentTables = GetParentTables(Composite);
+
+	TArray<UDataTable*> NewParentTables;
+	bool bParentsChanged = false;
+	for (UDataTable* Parent : ParentTables)
+	{
+		const bool bIsShard = Parent->GetName().StartsWith(Composite->GetName() + TEXT("_Shard"));
+		if (bIsShard && !Shards.ContainsByPredicate([Parent](const FShard& Shard) { return Shard.Table == Parent; }))
+		{
+			UE_LOG(LogTemp, Log, TEXT("Removed stale shard %s from %s, the asset can be deleted"), *Parent->GetName(), *Composite->GetName());
+			bParentsChanged = true;
+			continue;
+		}
+
+		NewParentTables.Add(Parent);
+	}
+
+	for (const FShard& Shard : Shards)
+	{
+		if (!ParentTables.Contains(Shard.Table))
+		{
+			NewParentTables.Add(Shard.Table);
+			bParentsChanged = true;
+		}
+	}
+
+	if (bParentsChanged)
+	{
+		Composite->Modify();
+		SetParentTables(Composite, NewParentTables);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Imported %s into %d shards (%d changed) in %.2fs"), *Composite->GetName(), NumShards, ChangedShards.Num(), FPlatformTime::Seconds() - StartTime);
+	return NumRows;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFPColumnMapping;
+class UCompositeDataTable;
+class UDataTable;
+
+/**
+ * Holds back the row list broadcasts of the tables added to it while it is open, imports of other tables broadcast as usual.
+ * A parent table's broadcast makes every composite built from it rebuild its rows, so when the scope closes the composites
+ * built from its tables (directly or through other composites) are unhooked, the tables broadcast, then each composite is
+ * rebuilt once with its parents first
+ */
+class FFPCompositeRebuildScope : public FNoncopyable
+{
+public:
+	FFPCompositeRebuildScope();
+	~FFPCompositeRebuildScope();
+
+	void AddTable(const UDataTable* Table);
+
+	/** Broadcast the table's row list change when the scope closes */
+	void Defer(UDataTable* Table);
+
+	/** The most recently opened scope holding back the table's broadcasts */
+	static FFPCompositeRebuildScope* Find(const UDataTable* Table);
+
+private:
+	TSet<TWeakObjectPtr<const UDataTable>> Tables;
+	TArray<TWeakObjectPtr<UDataTable>> DeferredTables;
+};
+
+namespace FPCompositeTables
+{
+	/** Broadcast a RowList change, deferred while a FFPCompositeRebuildScope holding the table is open */
+	void BroadcastRowListChanged(UDataTable* DataTable);
+
+	/** ParentTables is protected on UCompositeDataTable, read it through reflection */
+	TArray<UDataTable*> GetParentTables(const UCompositeDataTable* Composite);
+
+	/** Replace the parents and rebuild the composite */
+	void SetParentTables(UCompositeDataTable* Composite, const TArray<UDataTable*>& ParentTables);
+
+	/**
+	 * Split the CSV rows across NumShards child data tables (<Composite>_Shard<N>) which are the parents of the composite.
+	 * Rows go to a shard by a hash of the row name, or by sorted row name range when bByKeyRange is set. The key ranges are
+	 * pinned by the first import (the first row name of each shard is kept in its metadata), so later inserts only change
+	 * the shard they fall in, at the cost of shards growing unevenly. Changing the shard count pins them again. Shards left over from a larger shard count are removed
+	 * from the composite.
+	 * Shards are parsed in parallel, and shards whose rows did not change since the last import are left untouched.
+	 * Returns the number of rows imported.
+	 */
+	int32 ImportShardedCSV(UCompositeDataTable* Composite, FStringView CSV, const FFPColumnMapping& Mapping, int32 NumShards, bool bByKeyRange);
+}
@@ -9,8 +9,7 @@ const FString UFPGetGoogleSheets::ApiBaseUrl = "https://docs.google.com/spreadsh
 
 TSharedRef<IHttpRequest> UFPGetGoogleSheets::RequestWithRoute(FString Subroute)
 {
-	Http = &FHttpModule::Get();
-	TSharedRef<IHttpRequest> Request = Http->CreateRequest();
+	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
 	// Request->SetURL(UFPGetGoogleSheets::ApiBaseUrl + Subroute);
 	Request->SetURL(Subroute);
 	SetRequestHeaders(Request);
@@ -51,15 +50,38 @@ bool UFPGetGoogleSheets::ResponseIsValid(FHttpResponsePtr Response, bool bWasSuc
 	}
 }
 
-void UFPGetGoogleSheets::ProcessResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+bool UFPGetGoogleSheets::SupportsRowRanges(const FString& URL)
 {
-	OnResponseDelegate.ExecuteIfBound(Request, Response, bWasSuccessful);
+	if (!URL.Contains(TEXT("docs.google.com/spreadsheets/")) || URL.Contains(TEXT("range=")) || URL.Contains(TEXT("tq=")))
+	{
+		return false;
+	}
+
+	const bool bIsCSVExport = URL.Contains(TEXT("/export")) && URL.Contains(TEXT("format=csv"));
+	const bool bIsCSVQuery = URL.Contains(TEXT("/gviz/tq")) && URL.Contains(TEXT("out:csv"));
+	return bIsCSVExport || bIsCSVQuery;
 }
 
-void UFPGetGoogleSheets::SendRequest(FString DocId)
+FString UFPGetGoogleSheets::MakeRowRangeURL(const FString& URL, int32 FirstRow, int32 LastRow)
 {
-	// TSharedRef<IHttpRequest> Request = GetRequest(FString::Printf(TEXT("%s/export?format=csv"), *DocId));
-	TSharedRef<IHttpRequest> Request = GetRequest(*DocId);
-	Request->OnProcessRequestComplete().BindUObject(this, &UFPGetGoogleSheets::ProcessResponse);
-	Request->ProcessRequest();
+	// the fragment (e.g. #gid=0) isn't sent to the server
+	FString RangeURL;
+	if (!URL.Split(TEXT("#"), &RangeURL, nullptr))
+	{
+		RangeURL = URL;
+	}
+
+	RangeURL += RangeURL.Contains(TEXT("?")) ? TEXT("&") : TEXT("?");
+	RangeURL += LastRow == INDEX_NONE
+		? FString::Printf(TEXT("range=A%d:ZZZ"), FirstRow)
+		: FString::Printf(TEXT("range=A%d:ZZZ%d"), FirstRow, LastRow);
+
+	// otherwise gviz guesses whether the first row of the range is a header
+	if (RangeURL.Contains(TEXT("/gviz/tq")))
+	{
+		RangeURL += TEXT("&headers=0");
+	}
+
+	return RangeURL;
 }
+
@@ -6,27 +6,27 @@
 #include "Runtime/Online/HTTP/Public/Http.h"
 #include "FPGetGoogleSheet.generated.h"
 
-DECLARE_DELEGATE_ThreeParams(OnResponse, FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-
+/** Builds the requests for a sheet, they are sent (and kept alive) by UFPHttpSubsystem */
 UCLASS()
 class FPEDITORUTILITIES_API UFPGetGoogleSheets : public UObject
 {
 	GENERATED_BODY()
 
 public:	
-	OnResponse OnResponseDelegate;
+	static TSharedRef<IHttpRequest> GetRequest(FString Subroute);
+	static TSharedRef<IHttpRequest> PostRequest(FString Subroute, FString ContentJsonString);
+
+	/** Google Sheets CSV export and gviz urls which can serve a range of rows */
+	static bool SupportsRowRanges(const FString& URL);
 
-	void SendRequest(FString DocId);
+	/** The url limited to the sheet rows FirstRow to LastRow (1-based, inclusive), INDEX_NONE reads to the end of the sheet */
+	static FString MakeRowRangeURL(const FString& URL, int32 FirstRow, int32 LastRow);
+
+	static bool ResponseIsValid(FHttpResponsePtr Response, bool bWasSuccessful);
 
 private:
 	static const FString ApiBaseUrl;
-	FHttpModule* Http;
-
-	void ProcessResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-	void SetRequestHeaders(TSharedRef<IHttpRequest>& Request);
-	bool ResponseIsValid(FHttpResponsePtr Response, bool bWasSuccessful);
 
-	TSharedRef<IHttpRequest> GetRequest(FString Subroute);
-	TSharedRef<IHttpRequest> PostRequest(FString Subroute, FString ContentJsonString);
-	TSharedRef<IHttpRequest> RequestWithRoute(FString Subroute);
+	static void SetRequestHeaders(TSharedRef<IHttpRequest>& Request);
+	static TSharedRef<IHttpRequest> RequestWithRoute(FString Subroute);
 };
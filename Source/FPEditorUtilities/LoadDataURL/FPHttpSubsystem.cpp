@@ -0,0 +1,189 @@
+#include "FPHttpSubsystem.h"
+
+#include "Editor.h"
+#include "FPEditorUtilitySettings.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Interfaces/IHttpResponse.h"
+
+static FAutoConsoleCommand HttpStatsCommand(
+	TEXT("FP.HttpStats"),
+	TEXT("Log the queue depth and latency of URL import requests"),
+	FConsoleCommandDelegate::CreateLambda([]
+	{
+		UFPHttpSubsystem::Get().LogStats();
+	}));
+
+UFPHttpSubsystem& UFPHttpSubsystem::Get()
+{
+	check(GEditor);
+	return *GEditor->GetEditorSubsystem<UFPHttpSubsystem>();
+}
+
+void UFPHttpSubsystem::Deinitialize()
+{
+	// the importers are torn down with the module, don't call back into them
+	Pending.Reset();
+
+	for (const FHttpRequestPtr& Request : InFlight)
+	{
+		Request->OnProcessRequestComplete().Unbind();
+		Request->OnRequestProgress().Unbind();
+		Request->CancelRequest();
+	}
+
+	InFlight.Reset();
+	InFlightPerHost.Reset();
+
+	Super::Deinitialize();
+}
+
+FHttpRequestPtr UFPHttpSubsystem::Enqueue(TSharedRef<IHttpRequest> Request, EFPHttpPriority Priority, FHttpRequestCompleteDelegate OnComplete, FHttpRequestProgressDelegate OnProgress)
+{
+	// a queued request goes to a host which already has connections open, let them be reused
+	Request->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+	Request->OnRequestProgress() = MoveTemp(OnProgress);
+
+	FPendingRequest PendingRequest;
+	PendingRequest.Request = Request;
+	PendingRequest.Host = FGenericPlatformHttp::GetUrlDomain(Request->GetURL());
+	PendingRequest.Priority = Priority;
+	PendingRequest.QueuedTime = FPlatformTime::Seconds();
+	PendingRequest.OnComplete = MoveTemp(OnComplete);
+
+	// after every request of the same or higher priority
+	int32 InsertIndex = 0;
+	while (InsertIndex < Pending.Num() && Pending[InsertIndex].Priority >= Priority)
+	{
+		++InsertIndex;
+	}
+
+	Pending.Insert(MoveTemp(PendingRequest), InsertIndex);
+	Stats.NumQueued = Pending.Num();
+	Stats.PeakQueued = FMath::Max(Stats.PeakQueued, Stats.NumQueued);
+
+	SendPending();
+	return Request;
+}
+
+void UFPHttpSubsystem::Cancel(FHttpRequestPtr Request)
+{
+	if (!Request.IsValid())
+	{
+		return;
+	}
+
+	const int32 PendingIndex = Pending.IndexOfByPredicate([&Request](const FPendingRequest& Other) { return Other.Request == Request; });
+	if (PendingIndex != INDEX_NONE)
+	{
+		const FHttpRequestCompleteDelegate OnComplete = MoveTemp(Pending[PendingIndex].OnComplete);
+		Pending.RemoveAt(PendingIndex);
+		Stats.NumQueued = Pending.Num();
+		++Stats.NumCancelled;
+
+		OnComplete.ExecuteIfBound(Request, nullptr, false);
+		return;
+	}
+
+	// completes as failed through HandleComplete
+	if (InFlight.Contains(Request) && !CancelledInFlight.Contains(Request))
+	{
+		CancelledInFlight.Add(Request);
+		Request->CancelRequest();
+	}
+}
+
+void UFPHttpSubsystem::SendPending()
+{
+	// a request which fails to start completes right away and frees its slot while we're still sending
+	if (bSendingPending)
+	{
+		bSlotFreedWhileSending = true;
+		return;
+	}
+
+	TGuardValue<bool> SendingGuard(bSendingPending, true);
+
+	const int32 MaxRequestsPerHost = FMath::Max(1, UFPEditorUtilitySettings::Get().MaxRequestsPerHost);
+
+	do
+	{
+		bSlotFreedWhileSending = false;
+
+		for (int32 Index = 0; Index < Pending.Num(); )
+		{
+			if (InFlightPerHost.FindOrAdd(Pending[Index].Host) >= MaxRequestsPerHost)
+			{
+				++Index;
+				continue;
+			}
+
+			FPendingRequest Next = MoveTemp(Pending[Index]);
+			Pending.RemoveAt(Index);
+			Stats.NumQueued = Pending.Num();
+
+			++InFlightPerHost.FindChecked(Next.Host);
+			InFlight.Add(Next.Request);
+			Stats.NumInFlight = InFlight.Num();
+
+			const double SentTime = FPlatformTime::Seconds();
+			Stats.TotalWaitSeconds += SentTime - Next.QueuedTime;
+
+			Next.Request->OnProcessRequestComplete().BindUObject(this, &UFPHttpSubsystem::HandleComplete, Next.Host, Next.QueuedTime, SentTime, MoveTemp(Next.OnComplete));
+			Next.Request->ProcessRequest();
+		}
+	}
+	while (bSlotFreedWhileSending);
+}
+
+void UFPHttpSubsystem::HandleComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString Host, double QueuedTime, double SentTime, FHttpRequestCompleteDelegate OnComplete)
+{
+	InFlight.Remove(Request);
+	Stats.NumInFlight = InFlight.Num();
+
+	if (int32* NumInFlight = InFlightPerHost.Find(Host))
+	{
+		*NumInFlight = FMath::Max(0, *NumInFlight - 1);
+	}
+
+	if (CancelledInFlight.Remove(Request) > 0)
+	{
+		++Stats.NumCancelled;
+	}
+	else
+	{
+		const double Latency = FPlatformTime::Seconds() - SentTime;
+		Stats.TotalLatencySeconds += Latency;
+		Stats.MaxLatencySeconds = FMath::Max(Stats.MaxLatencySeconds, Latency);
+
+		if (bWasSuccessful && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+		{
+			++Stats.NumSucceeded;
+		}
+		else
+		{
+			++Stats.NumFailed;
+		}
+	}
+
+	// the freed slot goes to the next request before the response is handled, which may queue more
+	SendPending();
+
+	OnComplete.ExecuteIfBound(Request, Response, bWasSuccessful);
+}
+
+void UFPHttpSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("URL requests: %d queued (peak %d), %d in flight, %d succeeded, %d failed, %d cancelled"),
+		Stats.NumQueued, Stats.PeakQueued, Stats.NumInFlight, Stats.NumSucceeded, Stats.NumFailed, Stats.NumCancelled);
+
+	UE_LOG(LogTemp, Log, TEXT("URL requests: average wait %.2fs, average latency %.2fs, max latency %.2fs"),
+		Stats.GetAverageWaitSeconds(), Stats.GetAverageLatencySeconds(), Stats.MaxLatencySeconds);
+
+	for (const TPair<FString, int32>& Host : InFlightPerHost)
+	{
+		if (Host.Value > 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("  %s: %d in flight"), *Host.Key, Host.Value);
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "Interfaces/IHttpRequest.h"
+#include "FPHttpSubsystem.generated.h"
+
+UENUM()
+enum class EFPHttpPriority : uint8
+{
+	/** Batch reimports */
+	Low,
+	Normal,
+	/** Imports started from the URL entry */
+	High,
+};
+
+/** Queue depth and latency of the requests sent through UFPHttpSubsystem this session */
+struct FFPHttpStats
+{
+	int32 NumQueued = 0;
+	int32 NumInFlight = 0;
+	int32 PeakQueued = 0;
+
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+	int32 NumCancelled = 0;
+
+	/** Time between queueing a request and sending it */
+	double TotalWaitSeconds = 0.0;
+
+	/** Time between sending a request and its response */
+	double TotalLatencySeconds = 0.0;
+	double MaxLatencySeconds = 0.0;
+
+	int32 GetNumCompleted() const { return NumSucceeded + NumFailed; }
+	double GetAverageWaitSeconds() const { return GetNumCompleted() > 0 ? TotalWaitSeconds / GetNumCompleted() : 0.0; }
+	double GetAverageLatencySeconds() const { return GetNumCompleted() > 0 ? TotalLatencySeconds / GetNumCompleted() : 0.0; }
+};
+
+/**
+ * Owns the URL import requests. Requests wait in a priority queue (first in first out within a priority) and at most
+ * MaxRequestsPerHost of them are sent to a host at once, so a batch import reuses a few kept alive connections
+ */
+UCLASS()
+class FPEDITORUTILITIES_API UFPHttpSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UFPHttpSubsystem& Get();
+
+	virtual void Deinitialize() override;
+
+	/** Queue the request, OnComplete is called exactly once (without a response when it was cancelled) */
+	FHttpRequestPtr Enqueue(TSharedRef<IHttpRequest> Request, EFPHttpPriority Priority, FHttpRequestCompleteDelegate OnComplete, FHttpRequestProgressDelegate OnProgress = FHttpRequestProgressDelegate());
+
+	/** Drop the request if it is still queued, otherwise abort it */
+	void Cancel(FHttpRequestPtr Request);
+
+	const FFPHttpStats& GetStats() const { return Stats; }
+	void LogStats() const;
+
+private:
+	struct FPendingRequest
+	{
+		TSharedPtr<IHttpRequest> Request;
+		FString Host;
+		EFPHttpPriority Priority = EFPHttpPriority::Normal;
+		double QueuedTime = 0.0;
+		FHttpRequestCompleteDelegate OnComplete;
+	};
+
+	void SendPending();
+	void HandleComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString Host, double QueuedTime, double SentTime, FHttpRequestCompleteDelegate OnComplete);
+
+	/** Highest priority first */
+	TArray<FPendingRequest> Pending;
+
+	TSet<FHttpRequestPtr> InFlight;
+	TSet<FHttpRequestPtr> CancelledInFlight;
+	TMap<FString, int32> InFlightPerHost;
+
+	bool bSendingPending = false;
+	bool bSlotFreedWhileSending = false;
+
+	FFPHttpStats Stats;
+};
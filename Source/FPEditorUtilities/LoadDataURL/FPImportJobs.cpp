@@ -0,0 +1,325 @@
+#include "FPImportJobs.h"
+
+#include "FPHttpSubsystem.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+#include "Framework/Docking/TabManager.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Misc/LazySingleton.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Widgets/Views/SListView.h"
+
+static FName NAME_IMPORT_JOBS_TAB("FPImportJobs");
+
+FFPImportJob::FFPImportJob(int32 InId, TWeakObjectPtr<UObject> InObject, const FString& InURL)
+	: Id(InId)
+	, Object(InObject)
+	, AssetName(GetNameSafe(InObject.Get()))
+	, URL(InURL)
+	, StartTime(FPlatformTime::Seconds())
+	, Progress(MakeShared<FFPImportProgress>())
+{
+}
+
+void FFPImportJob::Cancel()
+{
+	if (!IsActive())
+	{
+		return;
+	}
+
+	Progress->bCancelled = true;
+
+	// the requests complete as failed, the response handler then finishes the job as cancelled
+	if (State == EFPImportJobState::Downloading)
+	{
+		for (const FHttpRequestPtr& Request : TArray<FHttpRequestPtr>(Requests))
+		{
+			UFPHttpSubsystem::Get().Cancel(Request);
+		}
+	}
+}
+
+void FFPImportJob::SetBytesReceived(int32 InBytesReceived, int32 SourceIndex)
+{
+	if (SourceBytesReceived.Num() <= SourceIndex)
+	{
+		SourceBytesReceived.SetNumZeroed(SourceIndex + 1);
+	}
+
+	SourceBytesReceived[SourceIndex] = InBytesReceived;
+}
+
+void FFPImportJob::HandleRequestProgress(FHttpRequestPtr Request, int32 BytesSent, int32 InBytesReceived, int32 SourceIndex)
+{
+	SetBytesReceived(InBytesReceived, SourceIndex);
+}
+
+int64 FFPImportJob::GetBytesReceived() const
+{
+	int64 Total = 0;
+	for (int32 Bytes : SourceBytesReceived)
+	{
+		Total += Bytes;
+	}
+	return Total;
+}
+
+void FFPImportJob::SetParsing()
+{
+	State = EFPImportJobState::Parsing;
+	ParseStartTime = FPlatformTime::Seconds();
+}
+
+void FFPImportJob::Finish(EFPImportJobState FinalState, const FText& InMessage)
+{
+	if (!IsActive())
+	{
+		return;
+	}
+
+	State = FinalState;
+	Message = InMessage;
+	EndTime = FPlatformTime::Seconds();
+
+	// a failed source stops the others, their completion is ignored now that the job is finished
+	const TArray<FHttpRequestPtr> OutstandingRequests = MoveTemp(Requests);
+	for (const FHttpRequestPtr& Request : OutstandingRequests)
+	{
+		UFPHttpSubsystem::Get().Cancel(Request);
+	}
+
+	Requests.Reset();
+
+	// the last job of a batch to finish rebuilds the composite tables
+	RebuildScope.Reset();
+
+	if (Notification.IsValid())
+	{
+		Notification->SetCompletionState(State == EFPImportJobState::Succeeded ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		Notification->ExpireAndFadeout();
+		Notification.Reset();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%s (%s)"), *GetStatusText().ToString(), *GetTimingText().ToString());
+	FFPImportJobManager::Get().HandleJobFinished();
+}
+
+FText FFPImportJob::GetStatusText() const
+{
+	const FText Asset = FText::FromString(AssetName);
+	const int32 RowsParsed = Progress->RowsParsed;
+
+	switch (State)
+	{
+		case EFPImportJobState::Downloading:
+			return FText::Format(INVTEXT("Importing {0}: {1} received"), Asset, FText::AsMemory(GetBytesReceived()));
+		case EFPImportJobState::Parsing:
+			return FText::Format(INVTEXT("Parsing {0}: {1} rows"), Asset, RowsParsed);
+		case EFPImportJobState::Succeeded:
+			return FText::Format(INVTEXT("Imported {0}: {1} rows"), Asset, RowsParsed);
+		case EFPImportJobState::Cancelled:
+			return FText::Format(INVTEXT("Cancelled import of {0}"), Asset);
+		default:
+			return Message.IsEmpty()
+				? FText::Format(INVTEXT("Failed to import {0}"), Asset)
+				: FText::Format(INVTEXT("Failed to import {0}: {1}"), Asset, Message);
+	}
+}
+
+FText FFPImportJob::GetTimingText() const
+{
+	FNumberFormattingOptions Seconds;
+	Seconds.SetMaximumFractionalDigits(2);
+
+	const double Now = IsActive() ? FPlatformTime::Seconds() : EndTime;
+	if (ParseStartTime <= 0.0)
+	{
+		return FText::Format(INVTEXT("download {0}s"), FText::AsNumber(Now - StartTime, &Seconds));
+	}
+
+	return FText::Format(INVTEXT("download {0}s, parse {1}s"), FText::AsNumber(ParseStartTime - StartTime, &Seconds), FText::AsNumber(Now - ParseStartTime, &Seconds));
+}
+
+class SFPImportJobRow : public SMultiColumnTableRow<TSharedPtr<FFPImportJob>>
+{
+public:
+	SLATE_BEGIN_ARGS(SFPImportJobRow)
+		{
+		}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, TSharedPtr<FFPImportJob> InJob, const TSharedRef<STableViewBase>& OwnerTable)
+	{
+		Job = InJob;
+		SMultiColumnTableRow::Construct(SMultiColumnTableRow::FArguments(), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		TSharedRef<FFPImportJob> JobRef = Job.ToSharedRef();
+
+		if (ColumnName == "Asset")
+		{
+			return SNew(STextBlock)
+				.Text(FText::FromString(JobRef->AssetName))
+				.ToolTipText(FText::FromString(JobRef->URL));
+		}
+
+		if (ColumnName == "Status")
+		{
+			return SNew(STextBlock).Text_Lambda([JobRef] { return JobRef->GetStatusText(); });
+		}
+
+		if (ColumnName == "Time")
+		{
+			return SNew(STextBlock).Text_Lambda([JobRef] { return JobRef->GetTimingText(); });
+		}
+
+		if (ColumnName == "Cancel")
+		{
+			return SNew(SButton)
+				.Text(INVTEXT("Cancel"))
+				.IsEnabled_Lambda([JobRef] { return JobRef->IsActive(); })
+				.OnClicked_Lambda([JobRef]
+				{
+					JobRef->Cancel();
+					return FReply::Handled();
+				});
+		}
+
+		return SNullWidget::NullWidget;
+	}
+
+	TSharedPtr<FFPImportJob> Job;
+};
+
+class SFPImportJobList : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SFPImportJobList)
+		{
+		}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs)
+	{
+		ChildSlot
+		[
+			SAssignNew(ListView, SListView<TSharedPtr<FFPImportJob>>)
+			.ListItemsSource(&Items)
+			.SelectionMode(ESelectionMode::None)
+			.OnGenerateRow_Lambda([](TSharedPtr<FFPImportJob> Job, const TSharedRef<STableViewBase>& OwnerTable)
+			{
+				return SNew(SFPImportJobRow, Job, OwnerTable);
+			})
+			.HeaderRow(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column("Asset").DefaultLabel(INVTEXT("Asset")).FillWidth(0.25f)
+				+ SHeaderRow::Column("Status").DefaultLabel(INVTEXT("Status")).FillWidth(0.45f)
+				+ SHeaderRow::Column("Time").DefaultLabel(INVTEXT("Time")).FillWidth(0.2f)
+				+ SHeaderRow::Column("Cancel").DefaultLabel(FText::GetEmpty()).FillWidth(0.1f))
+		];
+
+		RefreshItems();
+		FFPImportJobManager::Get().OnJobsChanged.AddSP(this, &SFPImportJobList::RefreshItems);
+	}
+
+private:
+	void RefreshItems()
+	{
+		// newest first
+		Items.Reset();
+		const TArray<TSharedRef<FFPImportJob>>& Jobs = FFPImportJobManager::Get().GetJobs();
+		for (int32 Index = Jobs.Num() - 1; Index >= 0; --Index)
+		{
+			Items.Add(Jobs[Index]);
+		}
+
+		ListView->RequestListRefresh();
+	}
+
+	TArray<TSharedPtr<FFPImportJob>> Items;
+	TSharedPtr<SListView<TSharedPtr<FFPImportJob>>> ListView;
+};
+
+FFPImportJobManager& FFPImportJobManager::Get()
+{
+	return TLazySingleton<FFPImportJobManager>::Get();
+}
+
+void FFPImportJobManager::TearDown()
+{
+	return TLazySingleton<FFPImportJobManager>::TearDown();
+}
+
+TSharedRef<FFPImportJob> FFPImportJobManager::StartJob(TWeakObjectPtr<UObject> Object, const FString& URL)
+{
+	TSharedRef<FFPImportJob> Job = MakeShared<FFPImportJob>(NextJobId++, Object, URL);
+
+	// each job has its own notification so concurrent imports don't fight over one
+	FNotificationInfo Info(TAttribute<FText>::CreateSP(Job, &FFPImportJob::GetStatusText));
+	Info.bUseThrobber = true;
+	Info.bFireAndForget = false;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(
+		INVTEXT("Cancel"),
+		INVTEXT("Stop downloading or parsing this import"),
+		FSimpleDelegate::CreateSP(Job, &FFPImportJob::Cancel),
+		SNotificationItem::CS_Pending));
+
+	Job->Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Job->Notification.IsValid())
+	{
+		Job->Notification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Begin importing %s from %s"), *Job->AssetName, *URL);
+
+	Jobs.Add(Job);
+	OnJobsChanged.Broadcast();
+	return Job;
+}
+
+void FFPImportJobManager::HandleJobFinished()
+{
+	int32 NumFinished = 0;
+	for (const TSharedRef<FFPImportJob>& Job : Jobs)
+	{
+		NumFinished += Job->IsActive() ? 0 : 1;
+	}
+
+	for (int32 Index = 0; Index < Jobs.Num() && NumFinished > MaxRecentJobs; )
+	{
+		if (Jobs[Index]->IsActive())
+		{
+			++Index;
+			continue;
+		}
+
+		Jobs.RemoveAt(Index);
+		--NumFinished;
+	}
+
+	OnJobsChanged.Broadcast();
+}
+
+void FFPImportJobManager::RegisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(NAME_IMPORT_JOBS_TAB, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs&)
+	{
+		return SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab)
+			[
+				SNew(SFPImportJobList)
+			];
+	}))
+	.SetDisplayName(INVTEXT("URL Imports"))
+	.SetTooltipText(INVTEXT("Active and recent data table and curve table imports"))
+	.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void FFPImportJobManager::UnregisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(NAME_IMPORT_JOBS_TAB);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FPTableParser.h"
+#include "Interfaces/IHttpRequest.h"
+
+class FFPCompositeRebuildScope;
+class SNotificationItem;
+
+enum class EFPImportJobState : uint8
+{
+	Downloading,
+	Parsing,
+	Succeeded,
+	Failed,
+	Cancelled,
+};
+
+/** One import into one asset from one or more sources, owns its notification and the requests */
+class FFPImportJob : public TSharedFromThis<FFPImportJob>
+{
+public:
+	FFPImportJob(int32 InId, TWeakObjectPtr<UObject> InObject, const FString& InURL);
+
+	/** Abort the requests, or stop the worker parsing the response */
+	void Cancel();
+
+	void SetBytesReceived(int32 InBytesReceived, int32 SourceIndex = 0);
+	void HandleRequestProgress(FHttpRequestPtr Request, int32 BytesSent, int32 InBytesReceived, int32 SourceIndex);
+	int64 GetBytesReceived() const;
+	void SetParsing();
+
+	/** Called by the importer once the rows are applied, or the import failed */
+	void Finish(EFPImportJobState FinalState, const FText& Message = FText::GetEmpty());
+
+	bool IsActive() const { return State == EFPImportJobState::Downloading || State == EFPImportJobState::Parsing; }
+	bool IsCancelled() const { return Progress->bCancelled; }
+
+	FText GetStatusText() const;
+	FText GetTimingText() const;
+
+	int32 Id = 0;
+	TWeakObjectPtr<UObject> Object;
+	FString AssetName;
+	FString URL;
+
+	EFPImportJobState State = EFPImportJobState::Downloading;
+	TArray<int32> SourceBytesReceived;
+	FText Message;
+
+	double StartTime = 0.0;
+	double ParseStartTime = 0.0;
+	double EndTime = 0.0;
+
+	/** Shared with the parsing worker, which may outlive the job */
+	TSharedRef<FFPImportProgress> Progress;
+
+	/** Owned by UFPHttpSubsystem, which may not have sent them yet */
+	TArray<FHttpRequestPtr> Requests;
+
+	/** Shared by the jobs of a batch import, released when the job finishes */
+	TSharedPtr<FFPCompositeRebuildScope> RebuildScope;
+
+	TSharedPtr<SNotificationItem> Notification;
+};
+
+class FFPImportJobManager
+{
+public:
+	static FFPImportJobManager& Get();
+	static void TearDown();
+
+	TSharedRef<FFPImportJob> StartJob(TWeakObjectPtr<UObject> Object, const FString& URL);
+
+	/** Oldest first, finished jobs are kept until there are more than MaxRecentJobs of them */
+	const TArray<TSharedRef<FFPImportJob>>& GetJobs() const { return Jobs; }
+
+	void RegisterTabSpawner();
+	void UnregisterTabSpawner();
+
+	FSimpleMulticastDelegate OnJobsChanged;
+
+private:
+	friend class FFPImportJob;
+	void HandleJobFinished();
+
+	static constexpr int32 MaxRecentJobs = 20;
+
+	TArray<TSharedRef<FFPImportJob>> Jobs;
+	int32 NextJobId = 1;
+};
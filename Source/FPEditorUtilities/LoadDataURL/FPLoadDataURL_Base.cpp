@@ -3,21 +3,82 @@
 #include "FPLoadDataURL_Base.h"
 
 #include "ContentBrowserModule.h"
+#include "DesktopPlatformModule.h"
+#include "FPCompositeTables.h"
+#include "FPEditorUtilitySettings.h"
+#include "IDesktopPlatform.h"
 #include "ObjectEditorUtils.h"
 #include "FPGetGoogleSheet.h"
 #include "ToolMenus.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "Async/Async.h"
+#include "Engine/DataTable.h"
 #include "Interfaces/IMainFrameModule.h"
+#include "Misc/FileHelper.h"
 #include "Misc/LazySingleton.h"
+#include "Widgets/Input/SSegmentedControl.h"
+#include "Widgets/Input/SSpinBox.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
 #define LOCTEXT_NAMESPACE "AssetTypeActions"
 
 static FName NAME_URL_SOURCE("FPURLSource");
+static FName NAME_URL_FORMAT("FPURLFormat");
+static FName NAME_URL_COLUMNS("FPURLColumns");
+static FName NAME_URL_SHARDS("FPURLShards");
+static FName NAME_URL_SHARD_BY_KEY_RANGE("FPURLShardByKeyRange");
+static FName NAME_URL_SOURCE_BYTES("FPURLSourceBytes");
+
+static FString GetSourceMetaData(const UObject* Object, FName Key)
+{
+	UPackage* AssetPackage = Object ? Object->GetPackage() : nullptr;
+	return AssetPackage ? AssetPackage->GetMetaData().GetValue(Object, Key) : FString();
+}
+
+static void SetSourceMetaData(UObject* Object, FName Key, const FString& Value)
+{
+	if (UPackage* AssetPackage = Object ? Object->GetPackage() : nullptr)
+	{
+		if (Value.IsEmpty())
+		{
+			AssetPackage->GetMetaData().RemoveValue(Object, Key);
+		}
+		else
+		{
+			AssetPackage->GetMetaData().SetValue(Object, Key, *Value);
+		}
+	}
+}
+
+FFPURLSourceSettings FFPURLSourceSettings::Load(const UObject* Object)
+{
+	FFPURLSourceSettings Settings;
+	Settings.URL = GetSourceMetaData(Object, NAME_URL_SOURCE);
+
+	const FString Format = GetSourceMetaData(Object, NAME_URL_FORMAT);
+	Settings.Format = Format == TEXT("CSV") ? EFPSourceFormat::CSV : Format == TEXT("JSON") ? EFPSourceFormat::JSON : EFPSourceFormat::Auto;
+
+	Settings.Columns = GetSourceMetaData(Object, NAME_URL_COLUMNS);
+	LexFromString(Settings.NumShards, *GetSourceMetaData(Object, NAME_URL_SHARDS));
+	Settings.bShardByKeyRange = GetSourceMetaData(Object, NAME_URL_SHARD_BY_KEY_RANGE).ToBool();
+	LexFromString(Settings.SourceBytes, *GetSourceMetaData(Object, NAME_URL_SOURCE_BYTES));
+	return Settings;
+}
+
+void FFPURLSourceSettings::Save(UObject* Object) const
+{
+	SetSourceMetaData(Object, NAME_URL_SOURCE, URL);
+	SetSourceMetaData(Object, NAME_URL_FORMAT, Format == EFPSourceFormat::CSV ? TEXT("CSV") : Format == EFPSourceFormat::JSON ? TEXT("JSON") : FString());
+	SetSourceMetaData(Object, NAME_URL_COLUMNS, Columns);
+	SetSourceMetaData(Object, NAME_URL_SHARDS, NumShards > 1 ? LexToString(NumShards) : FString());
+	SetSourceMetaData(Object, NAME_URL_SHARD_BY_KEY_RANGE, bShardByKeyRange ? TEXT("true") : FString());
+	SetSourceMetaData(Object, NAME_URL_SOURCE_BYTES, SourceBytes > 0 ? LexToString(SourceBytes) : FString());
+}
 
 void SFPURLEntry::Construct(const FArguments& InArgs)
 {
 	OnURLEntered = InArgs._OnUrlEntered;
+	Settings = InArgs._Settings;
 
 	ChildSlot
 	[
@@ -38,10 +99,66 @@ void SFPURLEntry::Construct(const FArguments& InArgs)
 				[
 					SAssignNew(EditableText, SEditableTextBox)
 					.MinDesiredWidth(500)
-					.Text(FText::FromString(InArgs._DefaultURL))
+					.Text(FText::FromString(Settings.URL))
+					.HintText(INVTEXT("URL or file path, data tables can merge several sources separated by |"))
 					.BackgroundColor(FSlateColor(FLinearColor(0.9f, 0.9f, 0.9f)))
 				]
 			]
+			+ SVerticalBox::Slot().AutoHeight().HAlign(HAlign_Left).Padding(FMargin(8.0f, 0.0f, 8.0f, 8.0f))
+			[
+				SNew(SSegmentedControl<EFPSourceFormat>)
+				.Visibility(InArgs._ShowFormat ? EVisibility::Visible : EVisibility::Collapsed)
+				.Value_Lambda([this] { return Settings.Format; })
+				.OnValueChanged_Lambda([this](EFPSourceFormat Format) { Settings.Format = Format; })
+				+ SSegmentedControl<EFPSourceFormat>::Slot(EFPSourceFormat::Auto)
+				.Text(INVTEXT("Auto"))
+				.ToolTip(INVTEXT("JSON when the response starts with [ or {, CSV otherwise"))
+				+ SSegmentedControl<EFPSourceFormat>::Slot(EFPSourceFormat::CSV)
+				.Text(INVTEXT("CSV"))
+				+ SSegmentedControl<EFPSourceFormat>::Slot(EFPSourceFormat::JSON)
+				.Text(INVTEXT("JSON"))
+				.ToolTip(INVTEXT("An array of row objects with a \"Name\" field, JSON Lines, or a Sheets API values response"))
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(FMargin(8.0f, 0.0f, 8.0f, 8.0f))
+			[
+				SAssignNew(ColumnsText, SEditableTextBox)
+				.Visibility(InArgs._ShowColumns ? EVisibility::Visible : EVisibility::Collapsed)
+				.MinDesiredWidth(500)
+				.Text(FText::FromString(Settings.Columns))
+				.HintText(INVTEXT("Columns or JSON fields to import (optional): SourceColumn=Property, OtherColumn"))
+				.ToolTipText(INVTEXT("Only these source columns are imported, everything else in the sheet is skipped. Leave empty to import every column."))
+				.BackgroundColor(FSlateColor(FLinearColor(0.9f, 0.9f, 0.9f)))
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(FMargin(8.0f, 0.0f, 8.0f, 8.0f))
+			[
+				SNew(SHorizontalBox)
+				.Visibility(InArgs._ShowShards ? EVisibility::Visible : EVisibility::Collapsed)
+				.ToolTipText(INVTEXT("Split the rows across child data tables which feed this composite table. Only shards whose rows changed are rewritten on reimport."))
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(FMargin(0.0f, 0.0f, 8.0f, 0.0f))
+				[
+					SNew(STextBlock)
+					.Text(INVTEXT("Shards"))
+				]
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+				[
+					SNew(SSpinBox<int32>)
+					.MinDesiredWidth(60)
+					.MinValue(0)
+					.MaxValue(64)
+					.Value_Lambda([this] { return Settings.NumShards; })
+					.OnValueChanged_Lambda([this](int32 Value) { Settings.NumShards = Value; })
+				]
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(FMargin(16.0f, 0.0f, 0.0f, 0.0f))
+				[
+					SNew(SCheckBox)
+					.IsChecked_Lambda([this] { return Settings.bShardByKeyRange ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+					.OnCheckStateChanged_Lambda([this](ECheckBoxState State) { Settings.bShardByKeyRange = State == ECheckBoxState::Checked; })
+					[
+						SNew(STextBlock)
+						.Text(INVTEXT("By key range (default is row name hash)"))
+					]
+				]
+			]
 			+ SVerticalBox::Slot().HAlign(HAlign_Fill).VAlign(VAlign_Center)
 			[
 				SNew(SHorizontalBox)
@@ -51,7 +168,9 @@ void SFPURLEntry::Construct(const FArguments& InArgs)
 					.Text(FText::FromString(TEXT("Apply")))
 					.OnClicked_Lambda([&]
 					{
-						OnURLEntered.ExecuteIfBound(EditableText->GetText().ToString());
+						Settings.URL = EditableText->GetText().ToString();
+						Settings.Columns = ColumnsText->GetText().ToString();
+						OnURLEntered.ExecuteIfBound(Settings);
 						FSlateApplication::Get().GetActiveTopLevelWindow()->RequestDestroyWindow();
 						return FReply::Handled();
 					})
@@ -73,8 +192,18 @@ void SFPURLEntry::Construct(const FArguments& InArgs)
 
 void FFPLoadDataURL_Base::Init()
 {
-	SetValidClasses(ValidAssetName, ValidAssetEditorName);
-	if (!ValidAssetName.IsValid() || !ValidAssetEditorName.IsValid())
+	SetValidClasses(ValidAssetClass, ValidAssetEditorName);
+	if (!ValidAssetClass || !ValidAssetEditorName.IsValid())
+	{
+		return;
+	}
+
+	GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OnAssetOpenedInEditor().AddRaw(this, &FFPLoadDataURL_Base::OnAssetOpenedInEditor);
+}
+
+void FFPLoadDataURL_Base::RegisterContentBrowserExtender()
+{
+	if (!ValidAssetClass || !ValidAssetEditorName.IsValid())
 	{
 		return;
 	}
@@ -82,8 +211,6 @@ void FFPLoadDataURL_Base::Init()
 	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
 	TArray<FContentBrowserMenuExtender_SelectedAssets>& CBAssetMenuExtenderDelegates = ContentBrowserModule.GetAllAssetViewContextMenuExtenders();
 	CBAssetMenuExtenderDelegates.Add(FContentBrowserMenuExtender_SelectedAssets::CreateRaw(this, &FFPLoadDataURL_Base::MakeContextMenuExtender));
-
-	GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OnAssetOpenedInEditor().AddRaw(this, &FFPLoadDataURL_Base::OnAssetOpenedInEditor);
 }
 
 void FFPLoadDataURL_Base::OnAssetOpenedInEditor(UObject* Asset, IAssetEditorInstance* AssetEditor)
@@ -117,80 +244,138 @@ void FFPLoadDataURL_Base::ExtendToolbar(FToolBarBuilder& ToolbarBuilder, TWeakOb
 
 TSharedRef<FExtender> FFPLoadDataURL_Base::MakeContextMenuExtender(const TArray<FAssetData>& AssetDataList)
 {
-	if (AssetDataList.Num() != 1 || AssetDataList[0].AssetClassPath.GetAssetName() != ValidAssetName)
-		return MakeShareable(new FExtender());
-
-	FAssetData AssetData;
-	// AssetData.FindTag()
+	// only look at the asset data here, the tables are loaded when an entry is used
+	TArray<FSoftObjectPath> AssetPaths;
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		if (AssetData.IsInstanceOf(ValidAssetClass))
+		{
+			AssetPaths.Add(AssetData.GetSoftObjectPath());
+		}
+	}
 
 	TSharedPtr<FExtender> MenuExtender = MakeShareable(new FExtender());
-
-	TWeakObjectPtr<UObject> Object = Cast<UObject>(AssetDataList[0].GetAsset());
+	if (AssetPaths.IsEmpty())
+	{
+		return MenuExtender.ToSharedRef();
+	}
 
 	MenuExtender->AddMenuExtension(
 		"ImportedAssetActions",
 		EExtensionHook::Before,
 		TSharedPtr<FUICommandList>(),
-		FMenuExtensionDelegate::CreateRaw(this, &FFPLoadDataURL_Base::AddMenuEntry, Object));
+		FMenuExtensionDelegate::CreateRaw(this, &FFPLoadDataURL_Base::AddMenuEntry, AssetPaths));
 
 	return MenuExtender.ToSharedRef();
 }
 
-void FFPLoadDataURL_Base::AddMenuEntry(FMenuBuilder& MenuBuilder, TWeakObjectPtr<UObject> Object)
+void FFPLoadDataURL_Base::AddMenuEntry(FMenuBuilder& MenuBuilder, TArray<FSoftObjectPath> AssetPaths)
 {
+	if (AssetPaths.Num() > 1)
+	{
+		MenuBuilder.AddMenuEntry(
+			FText::Format(INVTEXT("Import CSV ({0} selected)"), AssetPaths.Num()),
+			FText::FromString("Reimport each selected table from its stored URL"),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateRaw(this, &FFPLoadDataURL_Base::ImportFromStoredURLs, AssetPaths))
+		);
+		return;
+	}
+
+	const FSoftObjectPath AssetPath = AssetPaths[0];
+
 	MenuBuilder.AddMenuEntry(
 		FText::FromString("Import CSV"),
 		FText::FromString("Load data from URL"),
 		FSlateIcon(),
-		FUIAction(FExecuteAction::CreateRaw(this, &FFPLoadDataURL_Base::OpenWindow, Object))
+		FUIAction(FExecuteAction::CreateRaw(this, &FFPLoadDataURL_Base::OpenWindow, AssetPath))
+	);
+
+	MenuBuilder.AddMenuEntry(
+		FText::FromString("Export CSV"),
+		FText::FromString("Stream the table rows to a CSV file"),
+		FSlateIcon(),
+		FUIAction(FExecuteAction::CreateRaw(this, &FFPLoadDataURL_Base::OpenExportDialog, AssetPath, EFPTableExportFormat::CSV))
+	);
+
+	MenuBuilder.AddMenuEntry(
+		FText::FromString("Export JSON Lines"),
+		FText::FromString("Stream the table rows to a JSON Lines file, one row object per line"),
+		FSlateIcon(),
+		FUIAction(FExecuteAction::CreateRaw(this, &FFPLoadDataURL_Base::OpenExportDialog, AssetPath, EFPTableExportFormat::JSONLines))
 	);
 }
 
-void FFPLoadDataURL_Base::HandleURLEntered(FString URL, TWeakObjectPtr<UObject> Object)
+void FFPLoadDataURL_Base::ImportFromStoredURLs(TArray<FSoftObjectPath> AssetPaths)
 {
-	if (Object.IsValid())
+	// composites built from several of the tables are rebuilt once the last of the imports finishes
+	const TSharedRef<FFPCompositeRebuildScope> RebuildScope = MakeShared<FFPCompositeRebuildScope>();
+
+	TArray<FString> Skipped;
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
 	{
-		UObject* Table = Object.Get();
-		FString GoogleSheetId = URL;
+		// the url lives in the package metadata, so the table has to be loaded to read it
+		UObject* Object = AssetPath.TryLoad();
+		const FFPURLSourceSettings Settings = FFPURLSourceSettings::Load(Object);
+		if (!Object || Settings.URL.IsEmpty())
+		{
+			Skipped.Add(AssetPath.GetAssetName());
+			continue;
+		}
 
-		if (UPackage* AssetPackage = Object->GetPackage())
+		// behind anything imported by hand
+		const TSharedPtr<FFPImportJob> Job = ImportFromGoogleSheets(Object, Settings.URL, EFPHttpPriority::Low);
+		if (Job.IsValid() && Job->IsActive())
 		{
-			AssetPackage->GetMetaData().SetValue(Table, NAME_URL_SOURCE, *GoogleSheetId);
+			Job->RebuildScope = RebuildScope;
+			if (UDataTable* DataTable = Cast<UDataTable>(Object))
+			{
+				RebuildScope->AddTable(DataTable);
+			}
 		}
+	}
 
-		ImportFromGoogleSheets(Object, GoogleSheetId);
+	if (Skipped.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Skipped tables without a stored URL: %s"), *FString::Join(Skipped, TEXT(", ")));
 
-		// const TSharedPtr<SWindow> ActiveWindow = FSlateApplication::Get().GetActiveTopLevelWindow();
-		// ActiveWindow->RequestDestroyWindow();
+		FNotificationInfo Notification(FText::Format(INVTEXT("Skipped {0} tables without a stored URL, see the log"), Skipped.Num()));
+		Notification.ExpireDuration = 5.0f;
+		FSlateNotificationManager::Get().AddNotification(Notification);
 	}
 }
 
-TSharedRef<SWidget> FFPLoadDataURL_Base::MakeURLEntry(TWeakObjectPtr<UObject> Object)
+void FFPLoadDataURL_Base::HandleURLEntered(const FFPURLSourceSettings& Settings, TWeakObjectPtr<UObject> Object)
 {
-	FString DefaultURL;
-	if (UPackage* AssetPackage = Object->GetPackage())
+	if (Object.IsValid())
 	{
-		DefaultURL = AssetPackage->GetMetaData().GetValue(Object.Get(), NAME_URL_SOURCE);
+		Settings.Save(Object.Get());
+
+		ImportFromGoogleSheets(Object, Settings.URL, EFPHttpPriority::High);
+
+		// const TSharedPtr<SWindow> ActiveWindow = FSlateApplication::Get().GetActiveTopLevelWindow();
+		// ActiveWindow->RequestDestroyWindow();
 	}
+}
 
+TSharedRef<SWidget> FFPLoadDataURL_Base::MakeURLEntry(TWeakObjectPtr<UObject> Object)
+{
 	return SNew(SFPURLEntry)
-		.DefaultURL(DefaultURL)
+		.Settings(FFPURLSourceSettings::Load(Object.Get()))
+		.ShowFormat(SupportsJSON(Object.Get()))
+		.ShowColumns(SupportsColumnMapping(Object.Get()))
+		.ShowShards(SupportsSharding(Object.Get()))
 		.OnUrlEntered(FFPOnURLEntered::CreateRaw(this, &FFPLoadDataURL_Base::HandleURLEntered, Object));
 }
 
-void FFPLoadDataURL_Base::OpenWindow(TWeakObjectPtr<UObject> Object)
+void FFPLoadDataURL_Base::OpenWindow(FSoftObjectPath AssetPath)
 {
+	TWeakObjectPtr<UObject> Object = AssetPath.TryLoad();
 	if (!Object.IsValid())
 	{
 		return;
 	}
 
-	FString DefaultURL;
-	if (UPackage* AssetPackage = Object->GetPackage())
-	{
-		DefaultURL = AssetPackage->GetMetaData().GetValue(Object.Get(), NAME_URL_SOURCE);
-	}
-
 	TSharedRef<SWindow> Window = SNew(SWindow)
 		.Title(INVTEXT("Enter CSV URL"))
 		.CreateTitleBar(false)
@@ -201,56 +386,302 @@ void FFPLoadDataURL_Base::OpenWindow(TWeakObjectPtr<UObject> Object)
 		.ActivationPolicy(EWindowActivationPolicy::FirstShown)
 		[
 			SNew(SFPURLEntry)
-			.DefaultURL(DefaultURL)
+			.Settings(FFPURLSourceSettings::Load(Object.Get()))
+			.ShowFormat(SupportsJSON(Object.Get()))
+			.ShowColumns(SupportsColumnMapping(Object.Get()))
+			.ShowShards(SupportsSharding(Object.Get()))
 			.OnUrlEntered(FFPOnURLEntered::CreateRaw(this, &FFPLoadDataURL_Base::HandleURLEntered, Object))
 		];
 
 	FSlateApplication::Get().AddWindow(Window);
 }
 
-void FFPLoadDataURL_Base::ImportFromGoogleSheets(TWeakObjectPtr<UObject> Object, FString GoogleSheetsId)
+void FFPLoadDataURL_Base::OpenExportDialog(FSoftObjectPath AssetPath, EFPTableExportFormat Format)
 {
-	if (!Object.IsValid())
+	TWeakObjectPtr<UObject> Object = AssetPath.TryLoad();
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (!Object.IsValid() || !DesktopPlatform)
 	{
 		return;
 	}
 
-	UFPGetGoogleSheets* GetGoogleSheets = NewObject<UFPGetGoogleSheets>(UFPGetGoogleSheets::StaticClass());
-	GetGoogleSheets->OnResponseDelegate.BindRaw(this, &FFPLoadDataURL_Base::ReceiveResponse, Object);
-	GetGoogleSheets->SendRequest(GoogleSheetsId);
+	const FString Extension = FPTableExport::GetFileExtension(Format);
 
-	UE_LOG(LogTemp, Log, TEXT("Begin importing CSV"));
-	FNotificationInfo Notification(INVTEXT("Importing CSV"));
-	Notification.bUseThrobber = true;
-	Notification.bFireAndForget = false;
-	OngoingNotif = FSlateNotificationManager::Get().AddNotification(Notification);
-	OngoingNotif->SetCompletionState(SNotificationItem::CS_Pending);
+	TArray<FString> OutFiles;
+	const bool bPicked = DesktopPlatform->SaveFileDialog(
+		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+		TEXT("Export Table"),
+		FPaths::ProjectSavedDir(),
+		Object->GetName() + Extension,
+		FString::Printf(TEXT("Table Export (*%s)|*%s"), *Extension, *Extension),
+		EFileDialogFlags::None,
+		OutFiles);
+
+	if (!bPicked || OutFiles.IsEmpty())
+	{
+		return;
+	}
+
+	if (ExportToFile(Object.Get(), OutFiles[0], Format))
+	{
+		FSlateNotificationManager::Get().AddNotification(FNotificationInfo(FText::Format(INVTEXT("Exported to {0}"), FText::FromString(OutFiles[0]))));
+	}
+	else
+	{
+		FSlateNotificationManager::Get().AddNotification(FNotificationInfo(INVTEXT("Export failed")));
+	}
 }
 
-void FFPLoadDataURL_Base::ReceiveResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TWeakObjectPtr<UObject> Object)
+bool FFPLoadDataURL_Base::ExportToFile(UObject* Object, const FString& FilePath, EFPTableExportFormat Format)
 {
-	if (Response.IsValid() && bWasSuccessful && EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+	if (!Object)
 	{
-		ReceiveCSV(Response->GetContentAsString(), Object);
-		OngoingNotif->SetCompletionState(SNotificationItem::CS_Success);
-		FSlateNotificationManager::Get().AddNotification(FNotificationInfo(INVTEXT("Success")));
+		return false;
 	}
-	else
+
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Ar)
 	{
-		if (Response.IsValid())
+		UE_LOG(LogTemp, Error, TEXT("Failed to open %s for export"), *FilePath);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bExported = ExportRows(Object, *Ar, Format);
+	const bool bClosed = Ar->Close();
+
+	UE_LOG(LogTemp, Log, TEXT("Exported %s to %s in %.2fs"), *Object->GetName(), *FilePath, FPlatformTime::Seconds() - StartTime);
+	return bExported && bClosed;
+}
+
+/** The downloaded text of each source of a job, in source order */
+struct FFPSourceFetch
+{
+	TArray<FString> Texts;
+	int32 NumPending = 0;
+
+	/** The texts are row ranges of a single source */
+	bool bSlices = false;
+};
+
+TSharedPtr<FFPImportJob> FFPLoadDataURL_Base::ImportFromGoogleSheets(TWeakObjectPtr<UObject> Object, FString GoogleSheetsId, EFPHttpPriority Priority)
+{
+	if (!Object.IsValid())
+	{
+		return nullptr;
+	}
+
+	// several sources are separated by | or new lines, each is a url or a local file which may contain spaces
+	static const TCHAR* SourceSeparators[] = { TEXT("|"), TEXT("\r\n"), TEXT("\n") };
+	TArray<FString> Sources;
+	GoogleSheetsId.ParseIntoArray(Sources, SourceSeparators, UE_ARRAY_COUNT(SourceSeparators));
+	for (FString& Source : Sources)
+	{
+		Source.TrimStartAndEndInline();
+	}
+
+	Sources.RemoveAll([](const FString& Source) { return Source.IsEmpty(); });
+	if (Sources.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FFPImportJob> Job = FFPImportJobManager::Get().StartJob(Object, GoogleSheetsId);
+
+	if (Sources.Num() > 1 && !SupportsMultipleSources(Object.Get()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s only imports from one source but its url lists %d"), *Object->GetName(), Sources.Num());
+		Job->Finish(EFPImportJobState::Failed, INVTEXT("multiple sources are not supported for this asset type"));
+		return Job;
+	}
+
+	TSharedRef<FFPSourceFetch> Fetch = MakeShared<FFPSourceFetch>();
+
+	auto SendRequest = [this, Job, Fetch, Priority](const FString& URL, int32 SourceIndex)
+	{
+		Job->Requests.Add(UFPHttpSubsystem::Get().Enqueue(
+			UFPGetGoogleSheets::GetRequest(URL),
+			Priority,
+			FHttpRequestCompleteDelegate::CreateRaw(this, &FFPLoadDataURL_Base::ReceiveResponse, Job, Fetch, SourceIndex),
+			FHttpRequestProgressDelegate::CreateSP(Job, &FFPImportJob::HandleRequestProgress, SourceIndex)));
+	};
+
+	// a large sheet is fetched as concurrent row ranges, so the download takes about as long as its slowest slice
+	const int32 NumSlices = Sources.Num() == 1 ? GetNumSlices(Object.Get(), Sources[0]) : 1;
+	if (NumSlices > 1)
+	{
+		const int32 RowsPerSlice = FMath::DivideAndRoundUp(GetExpectedRows(Object.Get()), NumSlices);
+		UE_LOG(LogTemp, Log, TEXT("Fetching %s in %d slices of %d rows"), *Object->GetName(), NumSlices, RowsPerSlice);
+
+		Job->SourceBytesReceived.SetNumZeroed(NumSlices);
+		Fetch->Texts.SetNum(NumSlices);
+		Fetch->NumPending = NumSlices;
+		Fetch->bSlices = true;
+
+		for (int32 SliceIndex = 0; SliceIndex < NumSlices; ++SliceIndex)
 		{
-			FSlateNotificationManager::Get().AddNotification(FNotificationInfo(FText::Format(INVTEXT("Failed with error code {0}"), Response->GetResponseCode())));
-			UE_LOG(LogTemp, Error, TEXT("Http Response returned error code: %d"), Response->GetResponseCode());
+			// sheet row 1 is the header, which only the first slice includes. the last slice reads to the end in case the sheet grew
+			const int32 FirstRow = SliceIndex == 0 ? 1 : 2 + SliceIndex * RowsPerSlice;
+			const int32 LastRow = SliceIndex == NumSlices - 1 ? INDEX_NONE : 1 + (SliceIndex + 1) * RowsPerSlice;
+
+			SendRequest(UFPGetGoogleSheets::MakeRowRangeURL(Sources[0], FirstRow, LastRow), SliceIndex);
 		}
-		else
+
+		return Job;
+	}
+
+	Job->SourceBytesReceived.SetNumZeroed(Sources.Num());
+	Fetch->Texts.SetNum(Sources.Num());
+	Fetch->NumPending = Sources.Num();
+
+	// every source is fetched at once, so a merged import takes about as long as its slowest source
+	for (int32 SourceIndex = 0; SourceIndex < Sources.Num(); ++SourceIndex)
+	{
+		const FString& Source = Sources[SourceIndex];
+		if (!Source.StartsWith(TEXT("http://")) && !Source.StartsWith(TEXT("https://")))
 		{
-			FSlateNotificationManager::Get().AddNotification(FNotificationInfo(INVTEXT("Failed")));
+			Async(EAsyncExecution::ThreadPool, [this, Source, Job, Fetch, SourceIndex]()
+			{
+				// read as bytes so progress counts the file size like a download does, not the decoded characters
+				TArray<uint8> Bytes;
+				FString Text;
+				const bool bLoaded = FFileHelper::LoadFileToArray(Bytes, *Source);
+				if (bLoaded)
+				{
+					FFileHelper::BufferToString(Text, Bytes.GetData(), Bytes.Num());
+				}
+
+				AsyncTask(ENamedThreads::GameThread, [this, Source, Job, Fetch, SourceIndex, bLoaded, NumBytes = Bytes.Num(), Text = MoveTemp(Text)]() mutable
+				{
+					if (Job->IsCancelled())
+					{
+						Job->Finish(EFPImportJobState::Cancelled);
+						return;
+					}
+
+					if (!bLoaded)
+					{
+						UE_LOG(LogTemp, Error, TEXT("Failed to read %s"), *Source);
+						Job->Finish(EFPImportJobState::Failed, FText::Format(INVTEXT("failed to read {0}"), FText::FromString(Source)));
+						return;
+					}
+
+					Job->SetBytesReceived(NumBytes, SourceIndex);
+					ReceiveSource(MoveTemp(Text), Job, Fetch, SourceIndex);
+				});
+			});
+			continue;
 		}
 
-		OngoingNotif->SetCompletionState(SNotificationItem::CS_Fail);
+		SendRequest(Source, SourceIndex);
+	}
+
+	return Job;
+}
+
+void FFPLoadDataURL_Base::ReceiveResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TSharedRef<FFPImportJob> Job, TSharedRef<FFPSourceFetch> Fetch, int32 SourceIndex)
+{
+	if (Job->IsCancelled())
+	{
+		Job->Finish(EFPImportJobState::Cancelled);
+	}
+	else if (Response.IsValid() && bWasSuccessful && EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+	{
+		Job->SetBytesReceived(Response->GetContent().Num(), SourceIndex);
+		ReceiveSource(Response->GetContentAsString(), Job, Fetch, SourceIndex);
+	}
+	else if (Response.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Http Response returned error code: %d"), Response->GetResponseCode());
+		Job->Finish(EFPImportJobState::Failed, FText::Format(INVTEXT("error code {0}"), Response->GetResponseCode()));
+	}
+	else
+	{
+		Job->Finish(EFPImportJobState::Failed);
+	}
+}
+
+void FFPLoadDataURL_Base::ReceiveSource(FString Text, TSharedRef<FFPImportJob> Job, TSharedRef<FFPSourceFetch> Fetch, int32 SourceIndex)
+{
+	if (Job->IsCancelled())
+	{
+		Job->Finish(EFPImportJobState::Cancelled);
+		return;
+	}
+
+	// another source failed
+	if (!Job->IsActive())
+	{
+		return;
+	}
+
+	Fetch->Texts[SourceIndex] = MoveTemp(Text);
+	if (--Fetch->NumPending > 0)
+	{
+		return;
+	}
+
+	Job->SetParsing();
+
+	if (UObject* Object = Job->Object.Get())
+	{
+		FFPURLSourceSettings Settings = FFPURLSourceSettings::Load(Object);
+		Settings.SourceBytes = Job->GetBytesReceived();
+		Settings.Save(Object);
+	}
+
+	if (Fetch->bSlices)
+	{
+		ReceiveSlices(MoveTemp(Fetch->Texts), Job);
+	}
+	else if (Fetch->Texts.Num() == 1)
+	{
+		ReceiveCSV(MoveTemp(Fetch->Texts[0]), Job);
+	}
+	else
+	{
+		ReceiveSources(MoveTemp(Fetch->Texts), Job);
+	}
+}
+
+void FFPLoadDataURL_Base::ReceiveSources(TArray<FString> Texts, TSharedRef<FFPImportJob> Job)
+{
+	Job->Finish(EFPImportJobState::Failed, INVTEXT("multiple sources are not supported for this asset type"));
+}
+
+void FFPLoadDataURL_Base::ReceiveSlices(TArray<FString> Slices, TSharedRef<FFPImportJob> Job)
+{
+	FString CSV = MoveTemp(Slices[0]);
+	for (int32 Index = 1; Index < Slices.Num(); ++Index)
+	{
+		if (!CSV.IsEmpty() && !CSV.EndsWith(TEXT("\n")))
+		{
+			CSV += TEXT("\n");
+		}
+
+		CSV += Slices[Index];
+	}
+
+	ReceiveCSV(MoveTemp(CSV), Job);
+}
+
+int32 FFPLoadDataURL_Base::GetNumSlices(const UObject* Object, const FString& Source) const
+{
+	const UFPEditorUtilitySettings& Settings = UFPEditorUtilitySettings::Get();
+	const int32 ExpectedRows = GetExpectedRows(Object);
+	if (Settings.RowsPerSlice <= 0 || ExpectedRows <= Settings.RowsPerSlice || !UFPGetGoogleSheets::SupportsRowRanges(Source))
+	{
+		return 1;
+	}
+
+	// ranges are rows of CSV, and a sharded import parses the whole sheet itself
+	const FFPURLSourceSettings SourceSettings = FFPURLSourceSettings::Load(Object);
+	if (SourceSettings.Format == EFPSourceFormat::JSON || (SupportsSharding(Object) && SourceSettings.NumShards > 1))
+	{
+		return 1;
 	}
 
-	OngoingNotif->ExpireAndFadeout();
+	return FMath::Clamp(FMath::DivideAndRoundUp(ExpectedRows, Settings.RowsPerSlice), 1, Settings.MaxSlices);
 }
 
 #undef LOCTEXT_NAMESPACE
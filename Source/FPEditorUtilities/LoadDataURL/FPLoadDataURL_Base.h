@@ -3,16 +3,54 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FPHttpSubsystem.h"
+#include "FPImportJobs.h"
+#include "FPTableExport.h"
+#include "FPTableParser.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Toolkits/IToolkitHost.h"
 
-DECLARE_DELEGATE_OneParam(FFPOnURLEntered, FString);
+enum class EFPSourceFormat : uint8
+{
+	/** JSON when the response starts with an array or object, CSV otherwise */
+	Auto,
+	CSV,
+	JSON,
+};
+
+/** Per asset import settings, stored in the package metadata */
+struct FFPURLSourceSettings
+{
+	FString URL;
+
+	EFPSourceFormat Format = EFPSourceFormat::Auto;
+
+	/** See FFPColumnMapping */
+	FString Columns;
+
+	/** Composite data tables only: split the rows across this many child tables */
+	int32 NumShards = 0;
+	bool bShardByKeyRange = false;
+
+	/** Size of the last imported source, compared against the in memory size by the memory report */
+	int64 SourceBytes = 0;
+
+	static FFPURLSourceSettings Load(const UObject* Object);
+	void Save(UObject* Object) const;
+};
+
+struct FFPSourceFetch;
+
+DECLARE_DELEGATE_OneParam(FFPOnURLEntered, const FFPURLSourceSettings&);
 
 struct SFPURLEntry : SCompoundWidget
 {
 public:
-	SLATE_BEGIN_ARGS(SFPURLEntry) {}
-		SLATE_ARGUMENT(FString, DefaultURL)
+	SLATE_BEGIN_ARGS(SFPURLEntry) : _ShowFormat(false), _ShowColumns(false), _ShowShards(false) {}
+		SLATE_ARGUMENT(FFPURLSourceSettings, Settings)
+		SLATE_ARGUMENT(bool, ShowFormat)
+		SLATE_ARGUMENT(bool, ShowColumns)
+		SLATE_ARGUMENT(bool, ShowShards)
 		SLATE_ARGUMENT(FFPOnURLEntered, OnUrlEntered)
 	SLATE_END_ARGS()
 
@@ -20,26 +58,52 @@ public:
 
 private:
 	FFPOnURLEntered OnURLEntered;
+	FFPURLSourceSettings Settings;
 	TSharedPtr<SEditableTextBox> EditableText;
+	TSharedPtr<SEditableTextBox> ColumnsText;
 };
 
 class FFPLoadDataURL_Base
 {
 public:
+	/** Adds the Load URL button to the asset editors, they may be restored with the editor layout */
 	void Init();
-	void ImportFromGoogleSheets(TWeakObjectPtr<UObject> Object, FString GoogleSheetsId);
+
+	/** The Content Browser context menu is not needed until the first right click, so this can wait */
+	void RegisterContentBrowserExtender();
+
+	/** Returns the started job, if any */
+	TSharedPtr<FFPImportJob> ImportFromGoogleSheets(TWeakObjectPtr<UObject> Object, FString GoogleSheetsId, EFPHttpPriority Priority = EFPHttpPriority::Normal);
+
+	/** Stream the table rows to a file without building the whole export in memory */
+	bool ExportToFile(UObject* Object, const FString& FilePath, EFPTableExportFormat Format);
 
 protected:
 	~FFPLoadDataURL_Base() = default;
 
-	virtual void ReceiveResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TWeakObjectPtr<UObject> Object);
-	virtual void ReceiveCSV(FString String, TWeakObjectPtr<UObject> Object) = 0;
-	virtual void SetValidClasses(FName& OutAssetClassName, FName& OutAssetEditorName) = 0;
+	virtual void ReceiveResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TSharedRef<FFPImportJob> Job, TSharedRef<FFPSourceFetch> Fetch, int32 SourceIndex);
+
+	/** Apply the CSV to Job->Object, may continue on a worker but must end with Job->Finish */
+	virtual void ReceiveCSV(FString String, TSharedRef<FFPImportJob> Job) = 0;
+
+	/** Like ReceiveCSV for assets whose URL lists several sources, the texts are in source order */
+	virtual void ReceiveSources(TArray<FString> Texts, TSharedRef<FFPImportJob> Job);
+	virtual bool SupportsMultipleSources(const UObject* Object) const { return false; }
+
+	/** The rows of one source fetched as row ranges, only the first slice has the header. Stitches them for ReceiveCSV by default */
+	virtual void ReceiveSlices(TArray<FString> Slices, TSharedRef<FFPImportJob> Job);
+
+	/** Roughly how many rows the next import will have, a source is only fetched in slices when this is known */
+	virtual int32 GetExpectedRows(const UObject* Object) const { return 0; }
+	virtual void SetValidClasses(UClass*& OutAssetClass, FName& OutAssetEditorName) = 0;
+	virtual bool ExportRows(UObject* Object, FArchive& Ar, EFPTableExportFormat Format) = 0;
+	virtual bool SupportsJSON(const UObject* Object) const { return false; }
+	virtual bool SupportsColumnMapping(const UObject* Object) const { return false; }
+	virtual bool SupportsSharding(const UObject* Object) const { return false; }
 
 private:
-	FName ValidAssetName;
+	UClass* ValidAssetClass = nullptr;
 	FName ValidAssetEditorName;
-	TSharedPtr<SNotificationItem> OngoingNotif;
 
 	// make toolbar button
 	void OnAssetOpenedInEditor(UObject* Asset, IAssetEditorInstance* AssetEditor);
@@ -47,11 +111,21 @@ private:
 
 	// make asset context menu item  
 	TSharedRef<FExtender> MakeContextMenuExtender(const TArray<FAssetData>& AssetDataList);
-	void AddMenuEntry(FMenuBuilder& MenuBuilder, TWeakObjectPtr<UObject> Object);
+	void AddMenuEntry(FMenuBuilder& MenuBuilder, TArray<FSoftObjectPath> AssetPaths);
+
+	/** Batch reimport of the selected tables, tables without a stored URL are skipped */
+	void ImportFromStoredURLs(TArray<FSoftObjectPath> AssetPaths);
+
+	void HandleURLEntered(const FFPURLSourceSettings& Settings, TWeakObjectPtr<UObject> Object);
 
-	void HandleURLEntered(FString URL, TWeakObjectPtr<UObject> Object);
+	/** How many row ranges to fetch the source in, 1 when it can't be (or isn't worth) splitting */
+	int32 GetNumSlices(const UObject* Object, const FString& Source) const;
+
+	void ReceiveSource(FString Text, TSharedRef<FFPImportJob> Job, TSharedRef<FFPSourceFetch> Fetch, int32 SourceIndex);
 
 	TSharedRef<SWidget> MakeURLEntry(TWeakObjectPtr<UObject> Object);
 
-	void OpenWindow(TWeakObjectPtr<UObject> Object);
+	void OpenWindow(FSoftObjectPath AssetPath);
+
+	void OpenExportDialog(FSoftObjectPath AssetPath, EFPTableExportFormat Format);
 };
@@ -2,6 +2,8 @@
 
 #include "CurveTableEditorUtils.h"
 #include "Misc/LazySingleton.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
 
 FFPLoadDataURL_CurveTable& FFPLoadDataURL_CurveTable::Get()
 {
@@ -13,29 +15,116 @@ void FFPLoadDataURL_CurveTable::TearDown()
 	return TLazySingleton<FFPLoadDataURL_CurveTable>::TearDown();
 }
 
-void FFPLoadDataURL_CurveTable::ReceiveCSV(FString CSV, TWeakObjectPtr<UObject> Object)
+void FFPLoadDataURL_CurveTable::ReceiveCSV(FString CSV, TSharedRef<FFPImportJob> Job)
 {
-	if (!Object.IsValid())
+	if (!Job->Object.IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to import CurveTable: null obj"));
+		Job->Finish(EFPImportJobState::Failed, INVTEXT("the curve table is no longer valid"));
 		return;
 	}
 
-	UCurveTable* CurveTable = Cast<UCurveTable>(Object.Get());
+	UCurveTable* CurveTable = Cast<UCurveTable>(Job->Object.Get());
 	if (!CurveTable)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to import CurveTable: failed to cast"));
+		Job->Finish(EFPImportJobState::Failed);
 		return;
 	}
 
 	CurveTable->CreateTableFromCSVString(CSV);
+	Job->Progress->RowsParsed = CurveTable->GetRowMap().Num();
 	FCurveTableEditorUtils::BroadcastPostChange(CurveTable, FCurveTableEditorUtils::ECurveTableChangeInfo::RowList);
 	GEditor->RedrawAllViewports();
 	UE_LOG(LogTemp, Log, TEXT("Imported CurveTable"));
+	Job->Finish(EFPImportJobState::Succeeded);
 }
 
-void FFPLoadDataURL_CurveTable::SetValidClasses(FName& OutAssetClassName, FName& OutAssetEditorName)
+void FFPLoadDataURL_CurveTable::SetValidClasses(UClass*& OutAssetClass, FName& OutAssetEditorName)
 {
-	OutAssetClassName = UCurveTable::StaticClass()->GetFName();
+	OutAssetClass = UCurveTable::StaticClass();
 	OutAssetEditorName = FName("CurveTableEditor");
 }
+
+bool FFPLoadDataURL_CurveTable::ExportRows(UObject* Object, FArchive& Ar, EFPTableExportFormat Format)
+{
+	UCurveTable* CurveTable = Cast<UCurveTable>(Object);
+	if (!CurveTable)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to export CurveTable: failed to cast"));
+		return false;
+	}
+
+	TArray<TPair<FName, const FRealCurve*>> Rows;
+	Rows.Reserve(CurveTable->GetRowMap().Num());
+	for (const TPair<FName, FRealCurve*>& Row : CurveTable->GetRowMap())
+	{
+		Rows.Emplace(Row.Key, Row.Value);
+	}
+
+	if (Format == EFPTableExportFormat::CSV)
+	{
+		// curves don't have to share keys, so the header is the union of key times and a row leaves the times it has no key at empty
+		TSet<float> KeyTimeSet;
+		for (const TPair<FName, const FRealCurve*>& Row : Rows)
+		{
+			for (auto It = Row.Value->GetKeyHandleIterator(); It; ++It)
+			{
+				KeyTimeSet.Add(Row.Value->GetKeyTime(*It));
+			}
+		}
+
+		TArray<float> KeyTimes = KeyTimeSet.Array();
+		KeyTimes.Sort();
+
+		FString Header = TEXT("Name");
+		for (float KeyTime : KeyTimes)
+		{
+			Header.AppendChar(TEXT(','));
+			Header.Append(FString::SanitizeFloat(KeyTime));
+		}
+		FPTableExport::WriteLine(Ar, Header);
+
+		FPTableExport::WriteRows(Ar, Rows.Num(), [&](int32 RowIndex, FString& OutLine)
+		{
+			FPTableExport::AppendCSVCell(OutLine, Rows[RowIndex].Key.ToString());
+
+			// keys are sorted by time, so they are matched to the header in a single pass
+			auto KeyIt = Rows[RowIndex].Value->GetKeyHandleIterator();
+			for (float KeyTime : KeyTimes)
+			{
+				OutLine.AppendChar(TEXT(','));
+				if (KeyIt && Rows[RowIndex].Value->GetKeyTime(*KeyIt) == KeyTime)
+				{
+					OutLine.Append(FString::SanitizeFloat(Rows[RowIndex].Value->GetKeyValue(*KeyIt)));
+					++KeyIt;
+				}
+			}
+		});
+	}
+	else
+	{
+		FPTableExport::WriteRows(Ar, Rows.Num(), [&](int32 RowIndex, FString& OutLine)
+		{
+			const FRealCurve* Curve = Rows[RowIndex].Value;
+
+			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutLine);
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("Name"), Rows[RowIndex].Key.ToString());
+			Writer->WriteArrayStart(TEXT("Keys"));
+			for (auto It = Curve->GetKeyHandleIterator(); It; ++It)
+			{
+				const TPair<float, float> Key = Curve->GetKeyTimeValuePair(*It);
+				Writer->WriteArrayStart();
+				Writer->WriteValue(Key.Key);
+				Writer->WriteValue(Key.Value);
+				Writer->WriteArrayEnd();
+			}
+			Writer->WriteArrayEnd();
+			Writer->WriteObjectEnd();
+			Writer->Close();
+		});
+	}
+
+	return true;
+}
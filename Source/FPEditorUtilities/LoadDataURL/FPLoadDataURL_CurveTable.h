@@ -10,6 +10,7 @@ public:
 	static void TearDown();
 
 protected:
-	virtual void ReceiveCSV(FString CSV, TWeakObjectPtr<UObject> Object) override;
-	virtual void SetValidClasses(FName& OutAssetClassName, FName& OutAssetEditorName) override;
+	virtual void ReceiveCSV(FString CSV, TSharedRef<FFPImportJob> Job) override;
+	virtual void SetValidClasses(UClass*& OutAssetClass, FName& OutAssetEditorName) override;
+	virtual bool ExportRows(UObject* Object, FArchive& Ar, EFPTableExportFormat Format) override;
 };
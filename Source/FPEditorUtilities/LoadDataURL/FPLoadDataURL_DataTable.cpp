@@ -1,7 +1,16 @@
 ﻿#include "FPLoadDataURL_DataTable.h"
 
 #include "DataTableEditorUtils.h"
+#include "DataTableUtils.h"
+#include "FPCompositeTables.h"
+#include "FPEditorUtilitySettings.h"
+#include "Algo/Transform.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Engine/CompositeDataTable.h"
 #include "Misc/LazySingleton.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
 
 FFPLoadDataURL_DataTable& FFPLoadDataURL_DataTable::Get()
 {
@@ -13,29 +22,373 @@ void FFPLoadDataURL_DataTable::TearDown()
 	return TLazySingleton<FFPLoadDataURL_DataTable>::TearDown();
 }
 
-void FFPLoadDataURL_DataTable::ReceiveCSV(FString CSV, TWeakObjectPtr<UObject> Object)
+static void ApplyParsedRows(TSharedRef<FFPImportJob> Job, TSharedRef<FFPParsedRows> ParsedRows)
 {
-	if (!Object.IsValid())
+	if (Job->IsCancelled())
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to import datatable: nullptr"));
+		Job->Finish(EFPImportJobState::Cancelled);
 		return;
 	}
 
-	UDataTable* DataTable = Cast<UDataTable>(Object.Get());
+	UDataTable* DataTable = Cast<UDataTable>(Job->Object.Get());
 	if (!DataTable)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed import data table: cast failed"));
+		Job->Finish(EFPImportJobState::Failed, INVTEXT("the data table was unloaded while parsing"));
 		return;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Received CSV"));
-	DataTable->CreateTableFromCSVString(CSV);
-	FDataTableEditorUtils::BroadcastPostChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+	ParsedRows->ApplyTo(DataTable);
+
+	for (const FString& Problem : ParsedRows->Problems)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: %s"), *DataTable->GetName(), *Problem);
+	}
+
+	FPCompositeTables::BroadcastRowListChanged(DataTable);
 	GEditor->RedrawAllViewports();
+	Job->Finish(EFPImportJobState::Succeeded);
+}
+
+static bool IsJSONSource(EFPSourceFormat Format, FStringView Text)
+{
+	return Format == EFPSourceFormat::JSON || (Format == EFPSourceFormat::Auto && FPTableParser::LooksLikeJSON(Text));
+}
+
+static void ParseSource(FStringView Text, bool bIsJSON, const FFPColumnMapping& ColumnMapping, FFPParsedRows& OutRows)
+{
+	if (bIsJSON)
+	{
+		FPTableParser::ParseJSON(Text, ColumnMapping, OutRows);
+	}
+	else
+	{
+		FPTableParser::ParseCSV(Text, ColumnMapping, OutRows);
+	}
+}
+
+/** Parse every part (a source or a slice of one) on its own worker, then merge them by row name in order */
+static TSharedRef<FFPParsedRows> ParseAndMerge(int32 NumParts, TFunctionRef<void(int32, FFPParsedRows&)> ParsePart, const UScriptStruct* RowStruct, FFPImportProgress* Progress, bool bLastSourceWins, bool bParallel, TArray<FName>& OutConflicts)
+{
+	TArray<TUniquePtr<FFPParsedRows>> SourceRows;
+	SourceRows.SetNum(NumParts);
+
+	ParallelFor(NumParts, [&](int32 Index)
+	{
+		SourceRows[Index] = MakeUnique<FFPParsedRows>(RowStruct);
+		SourceRows[Index]->Progress = Progress;
+		ParsePart(Index, *SourceRows[Index]);
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	TSharedRef<FFPParsedRows> MergedRows = MakeShared<FFPParsedRows>(RowStruct);
+	for (const TUniquePtr<FFPParsedRows>& Rows : SourceRows)
+	{
+		OutConflicts.Append(MergedRows->MergeFrom(*Rows, bLastSourceWins));
+	}
+
+	return MergedRows;
+}
+
+static void ApplyMergedRows(TSharedRef<FFPImportJob> Job, TSharedRef<FFPParsedRows> MergedRows, const TArray<FName>& Conflicts, EFPMergeConflictPolicy Policy)
+{
+	if (!Conflicts.IsEmpty())
+	{
+		TArray<FString> ConflictNames;
+		Algo::Transform(Conflicts, ConflictNames, [](FName RowName) { return RowName.ToString(); });
+
+		if (Policy == EFPMergeConflictPolicy::Fail)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s: rows in more than one source: %s"), *Job->AssetName, *FString::Join(ConflictNames, TEXT(", ")));
+			Job->Finish(EFPImportJobState::Failed, FText::Format(INVTEXT("{0} rows are in more than one source, see the log"), Conflicts.Num()));
+			return;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("%s: %s kept for rows in more than one source: %s"),
+			*Job->AssetName,
+			Policy == EFPMergeConflictPolicy::LastSourceWins ? TEXT("last source") : TEXT("first source"),
+			*FString::Join(ConflictNames, TEXT(", ")));
+	}
+
+	ApplyParsedRows(Job, MergedRows);
 }
 
-void FFPLoadDataURL_DataTable::SetValidClasses(FName& OutAssetClassName, FName& OutAssetEditorName)
+using FFPParseMergedRows = TUniqueFunction<TSharedRef<FFPParsedRows>(bool bParallel, TArray<FName>& OutConflicts)>;
+
+/** Parse on a worker when the row struct allows it, the merged rows are applied (and broadcast) once on the game thread */
+static void ParseAndApplyMerged(TSharedRef<FFPImportJob> Job, const UScriptStruct* RowStruct, EFPMergeConflictPolicy Policy, FFPParseMergedRows Parse)
+{
+	if (!FPTableParser::CanParseOffGameThread(RowStruct))
+	{
+		TArray<FName> Conflicts;
+		TSharedRef<FFPParsedRows> MergedRows = Parse(false, Conflicts);
+		ApplyMergedRows(Job, MergedRows, Conflicts, Policy);
+		return;
+	}
+
+	Async(EAsyncExecution::ThreadPool, [Job, Policy, Parse = MoveTemp(Parse)]()
+	{
+		TArray<FName> Conflicts;
+		TSharedRef<FFPParsedRows> MergedRows = Parse(true, Conflicts);
+		AsyncTask(ENamedThreads::GameThread, [Job, MergedRows, Conflicts = MoveTemp(Conflicts), Policy]()
+		{
+			ApplyMergedRows(Job, MergedRows, Conflicts, Policy);
+		});
+	});
+}
+
+void FFPLoadDataURL_DataTable::ReceiveCSV(FString CSV, TSharedRef<FFPImportJob> Job)
 {
-	OutAssetClassName = UDataTable::StaticClass()->GetFName();
+	UDataTable* DataTable = Cast<UDataTable>(Job->Object.Get());
+	if (!DataTable)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed import data table: %s is no longer valid"), *Job->AssetName);
+		Job->Finish(EFPImportJobState::Failed, INVTEXT("the data table is no longer valid"));
+		return;
+	}
+
+	const FFPURLSourceSettings SourceSettings = FFPURLSourceSettings::Load(DataTable);
+	const FFPColumnMapping ColumnMapping = FFPColumnMapping::Parse(SourceSettings.Columns);
+
+	const bool bIsJSON = IsJSONSource(SourceSettings.Format, CSV);
+	UE_LOG(LogTemp, Log, TEXT("Received %s"), bIsJSON ? TEXT("JSON") : TEXT("CSV"));
+
+	UCompositeDataTable* CompositeTable = Cast<UCompositeDataTable>(DataTable);
+	if (CompositeTable && SourceSettings.NumShards > 1)
+	{
+		if (bIsJSON)
+		{
+			Job->Finish(EFPImportJobState::Failed, INVTEXT("sharded imports only support CSV sources"));
+			return;
+		}
+
+		// the rows live in the shards, the composite picks them up when the shards broadcast their change
+		Job->Progress->RowsParsed = FPCompositeTables::ImportShardedCSV(CompositeTable, CSV, ColumnMapping, SourceSettings.NumShards, SourceSettings.bShardByKeyRange);
+		GEditor->RedrawAllViewports();
+		Job->Finish(EFPImportJobState::Succeeded);
+		return;
+	}
+
+	if (!bIsJSON && ColumnMapping.IsEmpty())
+	{
+		DataTable->CreateTableFromCSVString(CSV);
+		Job->Progress->RowsParsed = DataTable->GetRowMap().Num();
+		FPCompositeTables::BroadcastRowListChanged(DataTable);
+		GEditor->RedrawAllViewports();
+		Job->Finish(EFPImportJobState::Succeeded);
+		return;
+	}
+
+	// only the mapped columns are tokenized into values, the rest of the sheet is skipped.
+	// json always goes through the pull parser, the stock json import builds a tree of the whole payload first
+	TSharedRef<FFPParsedRows> ParsedRows = MakeShared<FFPParsedRows>(DataTable->GetRowStruct());
+	ParsedRows->Progress = &Job->Progress.Get();
+
+	if (!FPTableParser::CanParseOffGameThread(DataTable->GetRowStruct()))
+	{
+		ParseSource(CSV, bIsJSON, ColumnMapping, *ParsedRows);
+		ApplyParsedRows(Job, ParsedRows);
+		return;
+	}
+
+	// parse on a worker so the editor stays responsive (and the job can be cancelled), the table is only touched on the game thread
+	Async(EAsyncExecution::ThreadPool, [CSV = MoveTemp(CSV), bIsJSON, ColumnMapping, Job, ParsedRows]()
+	{
+		ParseSource(CSV, bIsJSON, ColumnMapping, *ParsedRows);
+		AsyncTask(ENamedThreads::GameThread, [Job, ParsedRows]()
+		{
+			ApplyParsedRows(Job, ParsedRows);
+		});
+	});
+}
+
+void FFPLoadDataURL_DataTable::ReceiveSources(TArray<FString> Texts, TSharedRef<FFPImportJob> Job)
+{
+	UDataTable* DataTable = Cast<UDataTable>(Job->Object.Get());
+	if (!DataTable)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed import data table: %s is no longer valid"), *Job->AssetName);
+		Job->Finish(EFPImportJobState::Failed, INVTEXT("the data table is no longer valid"));
+		return;
+	}
+
+	const FFPURLSourceSettings SourceSettings = FFPURLSourceSettings::Load(DataTable);
+	if (DataTable->IsA<UCompositeDataTable>() && SourceSettings.NumShards > 1)
+	{
+		Job->Finish(EFPImportJobState::Failed, INVTEXT("sharded imports only support a single source"));
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Received %d sources"), Texts.Num());
+
+	// every source goes through the row parser, so the merged rows are applied (and broadcast) once
+	const FFPColumnMapping ColumnMapping = FFPColumnMapping::Parse(SourceSettings.Columns);
+	const EFPMergeConflictPolicy Policy = UFPEditorUtilitySettings::Get().MergeConflictPolicy;
+	const bool bLastSourceWins = Policy == EFPMergeConflictPolicy::LastSourceWins;
+	const UScriptStruct* RowStruct = DataTable->GetRowStruct();
+	FFPImportProgress* Progress = &Job->Progress.Get();
+
+	ParseAndApplyMerged(Job, RowStruct, Policy, [Texts = MoveTemp(Texts), Format = SourceSettings.Format, ColumnMapping, RowStruct, Progress, bLastSourceWins](bool bParallel, TArray<FName>& OutConflicts)
+	{
+		auto ParseText = [&](int32 Index, FFPParsedRows& OutRows)
+		{
+			ParseSource(Texts[Index], IsJSONSource(Format, Texts[Index]), ColumnMapping, OutRows);
+		};
+
+		return ParseAndMerge(Texts.Num(), ParseText, RowStruct, Progress, bLastSourceWins, bParallel, OutConflicts);
+	});
+}
+
+void FFPLoadDataURL_DataTable::ReceiveSlices(TArray<FString> Slices, TSharedRef<FFPImportJob> Job)
+{
+	UDataTable* DataTable = Cast<UDataTable>(Job->Object.Get());
+	if (!DataTable)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed import data table: %s is no longer valid"), *Job->AssetName);
+		Job->Finish(EFPImportJobState::Failed, INVTEXT("the data table is no longer valid"));
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Received %d slices"), Slices.Num());
+
+	// each slice is parsed against the header of the first one, the slices don't overlap so a row in two of them is a duplicate in the sheet
+	const FFPColumnMapping ColumnMapping = FFPColumnMapping::Parse(FFPURLSourceSettings::Load(DataTable).Columns);
+	const UScriptStruct* RowStruct = DataTable->GetRowStruct();
+	FFPImportProgress* Progress = &Job->Progress.Get();
+
+	ParseAndApplyMerged(Job, RowStruct, EFPMergeConflictPolicy::LastSourceWins, [Slices = MoveTemp(Slices), ColumnMapping, RowStruct, Progress](bool bParallel, TArray<FName>& OutConflicts)
+	{
+		const FStringView Header = FPTableParser::GetHeader(Slices[0]);
+		auto ParseSlice = [&](int32 Index, FFPParsedRows& OutRows)
+		{
+			if (Index == 0)
+			{
+				FPTableParser::ParseCSV(Slices[0], ColumnMapping, OutRows);
+			}
+			else
+			{
+				FPTableParser::ParseCSVBody(Header, Slices[Index], ColumnMapping, OutRows);
+			}
+		};
+
+		TSharedRef<FFPParsedRows> MergedRows = ParseAndMerge(Slices.Num(), ParseSlice, RowStruct, Progress, true, bParallel, OutConflicts);
+
+		for (FName RowName : OutConflicts)
+		{
+			MergedRows->Problems.Add(FString::Printf(TEXT("Duplicate row name '%s', the last one is kept"), *RowName.ToString()));
+		}
+
+		OutConflicts.Reset();
+		return MergedRows;
+	});
+}
+
+int32 FFPLoadDataURL_DataTable::GetExpectedRows(const UObject* Object) const
+{
+	const UDataTable* DataTable = Cast<UDataTable>(Object);
+	return DataTable ? DataTable->GetRowMap().Num() : 0;
+}
+
+void FFPLoadDataURL_DataTable::SetValidClasses(UClass*& OutAssetClass, FName& OutAssetEditorName)
+{
+	OutAssetClass = UDataTable::StaticClass();
 	OutAssetEditorName = FName("DataTableEditor");
 }
+
+bool FFPLoadDataURL_DataTable::SupportsSharding(const UObject* Object) const
+{
+	return Object && Object->IsA<UCompositeDataTable>();
+}
+
+bool FFPLoadDataURL_DataTable::ExportRows(UObject* Object, FArchive& Ar, EFPTableExportFormat Format)
+{
+	UDataTable* DataTable = Cast<UDataTable>(Object);
+	if (!DataTable || !DataTable->GetRowStruct())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to export data table: missing row struct"));
+		return false;
+	}
+
+	TArray<const FProperty*> Properties;
+	TArray<FString> ExportNames;
+	for (TFieldIterator<FProperty> It(DataTable->GetRowStruct()); It; ++It)
+	{
+		Properties.Add(*It);
+		ExportNames.Add(DataTableUtils::GetPropertyExportName(*It));
+	}
+
+	TArray<TPair<FName, const uint8*>> Rows;
+	Rows.Reserve(DataTable->GetRowMap().Num());
+	for (const TPair<FName, uint8*>& Row : DataTable->GetRowMap())
+	{
+		Rows.Emplace(Row.Key, Row.Value);
+	}
+
+	if (Format == EFPTableExportFormat::CSV)
+	{
+		FString Header = TEXT("---");
+		for (const FString& ExportName : ExportNames)
+		{
+			Header.AppendChar(TEXT(','));
+			FPTableExport::AppendCSVCell(Header, ExportName);
+		}
+		FPTableExport::WriteLine(Ar, Header);
+
+		FPTableExport::WriteRows(Ar, Rows.Num(), [&](int32 RowIndex, FString& OutLine)
+		{
+			FPTableExport::AppendCSVCell(OutLine, Rows[RowIndex].Key.ToString());
+			for (const FProperty* Property : Properties)
+			{
+				OutLine.AppendChar(TEXT(','));
+				FPTableExport::AppendCSVCell(OutLine, DataTableUtils::GetPropertyValueAsString(Property, Rows[RowIndex].Value, EDataTableExportFlags::None));
+			}
+		});
+	}
+	else
+	{
+		FPTableExport::WriteRows(Ar, Rows.Num(), [&](int32 RowIndex, FString& OutLine)
+		{
+			const uint8* RowData = Rows[RowIndex].Value;
+
+			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutLine);
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("Name"), Rows[RowIndex].Key.ToString());
+
+			for (int32 Index = 0; Index < Properties.Num(); ++Index)
+			{
+				const FProperty* Property = Properties[Index];
+				const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+				const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property);
+
+				if (NumericProperty && !NumericProperty->IsEnum())
+				{
+					const void* Value = Property->ContainerPtrToValuePtr<void>(RowData);
+					if (NumericProperty->IsFloatingPoint())
+					{
+						Writer->WriteValue(ExportNames[Index], NumericProperty->GetFloatingPointPropertyValue(Value));
+					}
+					else if (!NumericProperty->CanHoldValue(-1))
+					{
+						// as a raw token, an unsigned value above INT64_MAX would turn negative as a signed one
+						Writer->WriteRawJSONValue(ExportNames[Index], LexToString(NumericProperty->GetUnsignedIntPropertyValue(Value)));
+					}
+					else
+					{
+						Writer->WriteValue(ExportNames[Index], NumericProperty->GetSignedIntPropertyValue(Value));
+					}
+				}
+				else if (BoolProperty)
+				{
+					Writer->WriteValue(ExportNames[Index], BoolProperty->GetPropertyValue_InContainer(RowData));
+				}
+				else
+				{
+					Writer->WriteValue(ExportNames[Index], DataTableUtils::GetPropertyValueAsString(Property, RowData, EDataTableExportFlags::None));
+				}
+			}
+
+			Writer->WriteObjectEnd();
+			Writer->Close();
+		});
+	}
+
+	return true;
+}
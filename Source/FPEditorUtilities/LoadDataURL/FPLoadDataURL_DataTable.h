@@ -10,6 +10,14 @@ public:
 	static void TearDown();
 
 protected:
-	virtual void ReceiveCSV(FString CSV, TWeakObjectPtr<UObject> Object) override;
-	virtual void SetValidClasses(FName& OutAssetClassName, FName& OutAssetEditorName) override;
+	virtual void ReceiveCSV(FString CSV, TSharedRef<FFPImportJob> Job) override;
+	virtual void ReceiveSources(TArray<FString> Texts, TSharedRef<FFPImportJob> Job) override;
+	virtual bool SupportsMultipleSources(const UObject* Object) const override { return true; }
+	virtual void ReceiveSlices(TArray<FString> Slices, TSharedRef<FFPImportJob> Job) override;
+	virtual int32 GetExpectedRows(const UObject* Object) const override;
+	virtual void SetValidClasses(UClass*& OutAssetClass, FName& OutAssetEditorName) override;
+	virtual bool ExportRows(UObject* Object, FArchive& Ar, EFPTableExportFormat Format) override;
+	virtual bool SupportsJSON(const UObject* Object) const override { return true; }
+	virtual bool SupportsColumnMapping(const UObject* Object) const override { return true; }
+	virtual bool SupportsSharding(const UObject* Object) const override;
 };
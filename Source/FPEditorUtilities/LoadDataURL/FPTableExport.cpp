@@ -0,0 +1,198 @@
+#include "FPTableExport.h"
+
+#include "FPLoadDataURL_CurveTable.h"
+#include "FPLoadDataURL_DataTable.h"
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "IPAddress.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Engine/CurveTable.h"
+#include "Engine/DataTable.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+
+const TCHAR* FPTableExport::GetFileExtension(EFPTableExportFormat Format)
+{
+	return Format == EFPTableExportFormat::JSONLines ? TEXT(".jsonl") : TEXT(".csv");
+}
+
+const TCHAR* FPTableExport::GetContentType(EFPTableExportFormat Format)
+{
+	return Format == EFPTableExportFormat::JSONLines ? TEXT("application/x-ndjson") : TEXT("text/csv");
+}
+
+void FPTableExport::AppendCSVCell(FString& Out, FStringView Cell)
+{
+	Out.AppendChar(TEXT('"'));
+	for (TCHAR Char : Cell)
+	{
+		if (Char == TEXT('"'))
+		{
+			Out.AppendChar(TEXT('"'));
+		}
+		Out.AppendChar(Char);
+	}
+	Out.AppendChar(TEXT('"'));
+}
+
+void FPTableExport::WriteRows(FArchive& Ar, int32 NumRows, TFunctionRef<void(int32 RowIndex, FString& OutLine)> FormatRow, int32 BatchSize)
+{
+	TArray<FString> Lines;
+	FString Chunk;
+
+	for (int32 BatchStart = 0; BatchStart < NumRows; BatchStart += BatchSize)
+	{
+		const int32 BatchNum = FMath::Min(BatchSize, NumRows - BatchStart);
+
+		Lines.Reset();
+		Lines.SetNum(BatchNum);
+		ParallelFor(BatchNum, [&](int32 Index)
+		{
+			FormatRow(BatchStart + Index, Lines[Index]);
+		});
+
+		int32 ChunkLen = 0;
+		for (const FString& Line : Lines)
+		{
+			ChunkLen += Line.Len() + 1;
+		}
+
+		Chunk.Reset(ChunkLen);
+		for (const FString& Line : Lines)
+		{
+			Chunk.Append(Line);
+			Chunk.AppendChar(TEXT('\n'));
+		}
+
+		FTCHARToUTF8 Converter(*Chunk, Chunk.Len());
+		Ar.Serialize(const_cast<ANSICHAR*>(Converter.Get()), Converter.Length());
+	}
+}
+
+void FPTableExport::WriteLine(FArchive& Ar, const FString& Line)
+{
+	FTCHARToUTF8 Converter(*Line, Line.Len());
+	Ar.Serialize(const_cast<ANSICHAR*>(Converter.Get()), Converter.Length());
+
+	ANSICHAR NewLine = '\n';
+	Ar.Serialize(&NewLine, 1);
+}
+
+void FFPTableExportServer::Start(int32 Port)
+{
+	Stop();
+
+	// listeners bind every interface by default, only this machine may read the project's tables. the override has to be in
+	// place before the listener starts, it replaces any other override of the port and goes straight into the loaded section
+	// so the config isn't marked dirty and never saves it to Engine.ini
+	if (FConfigFile* EngineConfig = GConfig->FindConfigFile(GEngineIni))
+	{
+		static const FName NAME_ListenerOverrides("ListenerOverrides");
+		FConfigSection* Section = EngineConfig->FindOrAddSection(TEXT("HTTPServer.Listeners"));
+		for (auto It = Section->CreateKeyIterator(NAME_ListenerOverrides); It; ++It)
+		{
+			int32 OverridePort = 0;
+			if (FParse::Value(*It.Value().GetValue(), TEXT("Port="), OverridePort) && OverridePort == Port)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		Section->Add(NAME_ListenerOverrides, FConfigValue(FString::Printf(TEXT("(Port=%d,BindAddress=127.0.0.1)"), Port)));
+	}
+
+	Router = FHttpServerModule::Get().GetHttpRouter(Port);
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to start table export server on port %d"), Port);
+		return;
+	}
+
+	RouteHandle = Router->BindRoute(
+		FHttpPath(TEXT("/fpexport")),
+		EHttpServerRequestVerbs::VERB_GET,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			return HandleExportRequest(Request, OnComplete);
+		});
+
+	FHttpServerModule::Get().StartAllListeners();
+	UE_LOG(LogTemp, Log, TEXT("Table export server listening on http://127.0.0.1:%d/fpexport"), Port);
+}
+
+void FFPTableExportServer::Stop()
+{
+	if (Router.IsValid() && RouteHandle.IsValid())
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+
+	RouteHandle.Reset();
+	Router.Reset();
+}
+
+bool FFPTableExportServer::HandleExportRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	// in case the port was already bound to every interface by another router
+	const FString PeerAddress = Request.PeerAddress.IsValid() ? Request.PeerAddress->ToString(false) : FString();
+	if (!PeerAddress.StartsWith(TEXT("127.")) && !PeerAddress.StartsWith(TEXT("::ffff:127.")) && PeerAddress != TEXT("::1"))
+	{
+		OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::Forbidden, TEXT("NotLoopback"), TEXT("The export server only answers requests from this machine")));
+		return true;
+	}
+
+	const FString* AssetParam = Request.QueryParams.Find(TEXT("asset"));
+	if (!AssetParam)
+	{
+		OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest, TEXT("MissingAsset"), TEXT("Expected ?asset=/Game/Path/Table")));
+		return true;
+	}
+
+	const FString* FormatParam = Request.QueryParams.Find(TEXT("format"));
+	const EFPTableExportFormat Format = FormatParam && FormatParam->Equals(TEXT("jsonl"), ESearchCase::IgnoreCase)
+		? EFPTableExportFormat::JSONLines
+		: EFPTableExportFormat::CSV;
+
+	// accept package names as well as full object paths
+	FString AssetPath = *AssetParam;
+	if (!AssetPath.Contains(TEXT(".")))
+	{
+		AssetPath = FString::Printf(TEXT("%s.%s"), *AssetPath, *FPaths::GetBaseFilename(AssetPath));
+	}
+
+	// only tables known to the asset registry are loaded, not whatever object the query names
+	const FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(FSoftObjectPath(AssetPath));
+	const bool bDataTable = AssetData.IsValid() && AssetData.IsInstanceOf(UDataTable::StaticClass());
+	const bool bCurveTable = AssetData.IsValid() && AssetData.IsInstanceOf(UCurveTable::StaticClass());
+	if (!bDataTable && !bCurveTable)
+	{
+		OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::NotFound, TEXT("NotATable"), FString::Printf(TEXT("%s is not a DataTable or CurveTable"), *AssetPath)));
+		return true;
+	}
+
+	UObject* Table = AssetData.GetAsset();
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("FPExport") / FPaths::GetBaseFilename(AssetPath) + FPTableExport::GetFileExtension(Format);
+
+	bool bExported = false;
+	if (bDataTable && Table)
+	{
+		bExported = FFPLoadDataURL_DataTable::Get().ExportToFile(Table, FilePath, Format);
+	}
+	else if (bCurveTable && Table)
+	{
+		bExported = FFPLoadDataURL_CurveTable::Get().ExportToFile(Table, FilePath, Format);
+	}
+
+	// the http server needs the whole body up front, so the file is only read back once it is fully written
+	TArray<uint8> Body;
+	if (!bExported || !FFileHelper::LoadFileToArray(Body, *FilePath))
+	{
+		OnComplete(FHttpServerResponse::Error(EHttpServerResponseCodes::NotFound, TEXT("ExportFailed"), FString::Printf(TEXT("Failed to export %s"), *AssetPath)));
+		return true;
+	}
+
+	OnComplete(FHttpServerResponse::Create(MoveTemp(Body), FPTableExport::GetContentType(Format)));
+	return true;
+}
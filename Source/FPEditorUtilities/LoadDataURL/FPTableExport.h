@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpResultCallback.h"
+#include "HttpRouteHandle.h"
+
+struct FHttpServerRequest;
+class IHttpRouter;
+
+enum class EFPTableExportFormat : uint8
+{
+	CSV,
+	JSONLines,
+};
+
+namespace FPTableExport
+{
+	const TCHAR* GetFileExtension(EFPTableExportFormat Format);
+	const TCHAR* GetContentType(EFPTableExportFormat Format);
+
+	/** Quote a cell for CSV, doubling any quotes inside it */
+	void AppendCSVCell(FString& Out, FStringView Cell);
+
+	/**
+	 * Write rows to the archive as UTF-8 in batches of BatchSize.
+	 * Each batch is formatted in parallel and written in row order, so only one batch of row strings is alive at a time.
+	 * FormatRow must be safe to call from worker threads.
+	 */
+	void WriteRows(FArchive& Ar, int32 NumRows, TFunctionRef<void(int32 RowIndex, FString& OutLine)> FormatRow, int32 BatchSize = 1024);
+
+	void WriteLine(FArchive& Ar, const FString& Line);
+}
+
+/** Serves table exports to this machine only, e.g. http://127.0.0.1:8765/fpexport?asset=/Game/Data/DT_Loot&format=csv */
+class FFPTableExportServer
+{
+public:
+	void Start(int32 Port);
+	void Stop();
+
+private:
+	bool HandleExportRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+};
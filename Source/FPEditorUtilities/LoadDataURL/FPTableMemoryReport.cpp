@@ -0,0 +1,399 @@
+#include "FPTableMemoryReport.h"
+
+#include "FPLoadDataURL_Base.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/CurveTable.h"
+#include "Engine/DataTable.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Views/SListView.h"
+
+static FName NAME_TABLE_MEMORY_TAB("FPTableMemory");
+
+namespace FPTableMemoryReport
+{
+	/** Rough cost of the shared text data behind an FText, on top of its display string */
+	static constexpr int64 TextDataBytes = 64;
+
+	class FMemoryCounter
+	{
+	public:
+		void CountStruct(const UStruct* Struct, const void* Data)
+		{
+			for (TFieldIterator<FProperty> It(Struct); It; ++It)
+			{
+				for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+				{
+					CountProperty(*It, It->ContainerPtrToValuePtr<void>(Data, Index));
+				}
+			}
+		}
+
+		void CountProperty(const FProperty* Property, const void* Value)
+		{
+			if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+			{
+				HeapBytes += StrProperty->GetPropertyValue(Value).GetAllocatedSize();
+			}
+			else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+			{
+				AddName(NameProperty->GetPropertyValue(Value));
+			}
+			else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+			{
+				const FText& Text = TextProperty->GetPropertyValue(Value);
+				NameTextBytes += Text.IsEmpty() ? 0 : TextDataBytes + Text.ToString().GetAllocatedSize();
+			}
+			else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				CountStruct(StructProperty->Struct, Value);
+			}
+			else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			{
+				FScriptArrayHelper Helper(ArrayProperty, Value);
+				HeapBytes += static_cast<int64>(Helper.Num()) * ArrayProperty->Inner->GetElementSize();
+				for (int32 Index = 0; Index < Helper.Num(); ++Index)
+				{
+					CountProperty(ArrayProperty->Inner, Helper.GetRawPtr(Index));
+				}
+			}
+			else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+			{
+				FScriptSetHelper Helper(SetProperty, Value);
+				HeapBytes += static_cast<int64>(Helper.GetMaxIndex()) * SetProperty->SetLayout.Size;
+				for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+				{
+					if (Helper.IsValidIndex(Index))
+					{
+						CountProperty(SetProperty->ElementProp, Helper.GetElementPtr(Index));
+					}
+				}
+			}
+			else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			{
+				FScriptMapHelper Helper(MapProperty, Value);
+				HeapBytes += static_cast<int64>(Helper.GetMaxIndex()) * MapProperty->MapLayout.SetLayout.Size;
+				for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+				{
+					if (Helper.IsValidIndex(Index))
+					{
+						CountProperty(MapProperty->KeyProp, Helper.GetKeyPtr(Index));
+						CountProperty(MapProperty->ValueProp, Helper.GetValuePtr(Index));
+					}
+				}
+			}
+		}
+
+		/** Name entries are shared, so each unique name is only counted once per table */
+		void AddName(FName Name)
+		{
+			bool bAlreadyCounted = false;
+			Names.Add(Name.GetComparisonIndex(), &bAlreadyCounted);
+			if (!bAlreadyCounted && !Name.IsNone())
+			{
+				NameTextBytes += Name.GetStringLength() + sizeof(uint16);
+			}
+		}
+
+		int64 HeapBytes = 0;
+		int64 NameTextBytes = 0;
+
+	private:
+		TSet<FNameEntryId> Names;
+	};
+
+	static bool IsTableClass(const FAssetData& AssetData)
+	{
+		return AssetData.IsInstanceOf(UDataTable::StaticClass()) || AssetData.IsInstanceOf(UCurveTable::StaticClass());
+	}
+
+	static FText BytesText(int64 Bytes)
+	{
+		return Bytes > 0 ? FText::AsMemory(Bytes) : INVTEXT("-");
+	}
+
+	class SFPTableMemoryRow : public SMultiColumnTableRow<TSharedPtr<FFPTableMemoryEntry>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SFPTableMemoryRow)
+			{
+			}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, TSharedPtr<FFPTableMemoryEntry> InEntry, const TSharedRef<STableViewBase>& OwnerTable)
+		{
+			Entry = InEntry;
+			SMultiColumnTableRow::Construct(SMultiColumnTableRow::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if (ColumnName == "Table")
+			{
+				return SNew(STextBlock)
+					.Text(FText::FromString(Entry->Path.GetAssetName()))
+					.ToolTipText(FText::FromString(Entry->Path.ToString()))
+					.ColorAndOpacity(Entry->bLoaded ? FSlateColor::UseForeground() : FSlateColor::UseSubduedForeground());
+			}
+
+			if (ColumnName == "Rows")
+			{
+				Text = Entry->bLoaded ? FText::AsNumber(Entry->NumRows) : INVTEXT("not loaded");
+			}
+			else if (ColumnName == "RowBytes")
+			{
+				Text = BytesText(Entry->RowBytes);
+			}
+			else if (ColumnName == "HeapBytes")
+			{
+				Text = BytesText(Entry->HeapBytes);
+			}
+			else if (ColumnName == "NameTextBytes")
+			{
+				Text = BytesText(Entry->NameTextBytes);
+			}
+			else if (ColumnName == "MemoryBytes")
+			{
+				Text = BytesText(Entry->GetMemoryBytes());
+			}
+			else if (ColumnName == "SourceBytes")
+			{
+				// the source size lives in the package metadata, which is only there once the table is loaded
+				Text = Entry->bLoaded ? BytesText(Entry->SourceBytes) : INVTEXT("n/a");
+			}
+			else if (ColumnName == "Ratio")
+			{
+				Text = Entry->bLoaded && Entry->SourceBytes > 0
+					? FText::Format(INVTEXT("{0}x"), FText::AsNumber(static_cast<double>(Entry->GetMemoryBytes()) / Entry->SourceBytes, &FNumberFormattingOptions::DefaultNoGrouping()))
+					: INVTEXT("-");
+			}
+			else if (ColumnName == "DiskBytes")
+			{
+				Text = BytesText(Entry->DiskBytes);
+			}
+
+			return SNew(STextBlock).Text(Text);
+		}
+
+		TSharedPtr<FFPTableMemoryEntry> Entry;
+	};
+
+	class SFPTableMemoryReport : public SCompoundWidget
+	{
+	public:
+		SLATE_BEGIN_ARGS(SFPTableMemoryReport)
+			{
+			}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs)
+		{
+			ChildSlot
+			[
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot().AutoHeight().Padding(4.0f)
+				[
+					SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot().AutoWidth()
+					[
+						SNew(SButton)
+						.Text(INVTEXT("Refresh"))
+						.OnClicked_Lambda([this]
+						{
+							RefreshItems();
+							return FReply::Handled();
+						})
+					]
+					+ SHorizontalBox::Slot().FillWidth(1.0f).VAlign(VAlign_Center).Padding(FMargin(8.0f, 0.0f))
+					[
+						SNew(STextBlock)
+						.Text_Lambda([this] { return SummaryText; })
+					]
+				]
+				+ SVerticalBox::Slot().FillHeight(1.0f)
+				[
+					SAssignNew(ListView, SListView<TSharedPtr<FFPTableMemoryEntry>>)
+					.ListItemsSource(&Items)
+					.OnGenerateRow_Lambda([](TSharedPtr<FFPTableMemoryEntry> Entry, const TSharedRef<STableViewBase>& OwnerTable)
+					{
+						return SNew(SFPTableMemoryRow, Entry, OwnerTable);
+					})
+					.HeaderRow(
+						SNew(SHeaderRow)
+						+ SHeaderRow::Column("Table").DefaultLabel(INVTEXT("Table")).FillWidth(0.25f)
+						+ SHeaderRow::Column("Rows").DefaultLabel(INVTEXT("Rows")).FillWidth(0.08f)
+						+ SHeaderRow::Column("RowBytes").DefaultLabel(INVTEXT("Row Structs")).FillWidth(0.09f)
+						+ SHeaderRow::Column("HeapBytes").DefaultLabel(INVTEXT("Heap")).FillWidth(0.09f)
+						+ SHeaderRow::Column("NameTextBytes").DefaultLabel(INVTEXT("Names / Text")).FillWidth(0.09f)
+						+ SHeaderRow::Column("MemoryBytes").DefaultLabel(INVTEXT("Total")).FillWidth(0.1f)
+						+ SHeaderRow::Column("SourceBytes").DefaultLabel(INVTEXT("Source")).FillWidth(0.1f)
+						+ SHeaderRow::Column("Ratio").DefaultLabel(INVTEXT("Total / Source")).FillWidth(0.1f)
+						+ SHeaderRow::Column("DiskBytes").DefaultLabel(INVTEXT("Disk")).FillWidth(0.1f))
+				]
+			];
+
+			RefreshItems();
+		}
+
+	private:
+		void RefreshItems()
+		{
+			Items.Reset();
+
+			int64 LoadedBytes = 0;
+			int32 NumLoaded = 0;
+			for (FFPTableMemoryEntry& Entry : Build())
+			{
+				LoadedBytes += Entry.bLoaded ? Entry.GetMemoryBytes() : 0;
+				NumLoaded += Entry.bLoaded ? 1 : 0;
+				Items.Add(MakeShared<FFPTableMemoryEntry>(MoveTemp(Entry)));
+			}
+
+			SummaryText = FText::Format(INVTEXT("{0} tables, {1} loaded using {2}. Unloaded tables are sorted by their size on disk."), Items.Num(), NumLoaded, FText::AsMemory(LoadedBytes));
+			ListView->RequestListRefresh();
+		}
+
+		FText SummaryText;
+		TArray<TSharedPtr<FFPTableMemoryEntry>> Items;
+		TSharedPtr<SListView<TSharedPtr<FFPTableMemoryEntry>>> ListView;
+	};
+
+	static FAutoConsoleCommand TableMemoryReportCommand(
+		TEXT("FP.TableMemoryReport"),
+		TEXT("Log the estimated memory of every DataTable and CurveTable, most expensive first"),
+		FConsoleCommandDelegate::CreateLambda([]
+		{
+			LogReport(Build());
+		}));
+}
+
+FFPTableMemoryEntry FPTableMemoryReport::Measure(const UObject* Table)
+{
+	FFPTableMemoryEntry Entry;
+	Entry.Path = FSoftObjectPath(Table);
+	Entry.ClassName = Table->GetClass()->GetFName();
+	Entry.bLoaded = true;
+	Entry.SourceBytes = FFPURLSourceSettings::Load(Table).SourceBytes;
+
+	FMemoryCounter Counter;
+
+	if (const UDataTable* DataTable = Cast<UDataTable>(Table))
+	{
+		const UScriptStruct* RowStruct = DataTable->GetRowStruct();
+		const TMap<FName, uint8*>& RowMap = DataTable->GetRowMap();
+
+		Entry.NumRows = RowMap.Num();
+		Entry.RowBytes = RowStruct ? static_cast<int64>(RowMap.Num()) * RowStruct->GetStructureSize() : 0;
+		Counter.HeapBytes += RowMap.GetAllocatedSize();
+
+		for (const TPair<FName, uint8*>& Row : RowMap)
+		{
+			Counter.AddName(Row.Key);
+			if (RowStruct)
+			{
+				Counter.CountStruct(RowStruct, Row.Value);
+			}
+		}
+	}
+	else if (const UCurveTable* CurveTable = Cast<UCurveTable>(Table))
+	{
+		const bool bSimpleCurves = CurveTable->GetCurveTableMode() == ECurveTableMode::SimpleCurves;
+		const TMap<FName, FRealCurve*>& RowMap = CurveTable->GetRowMap();
+
+		Entry.NumRows = RowMap.Num();
+		Entry.RowBytes = static_cast<int64>(RowMap.Num()) * (bSimpleCurves ? sizeof(FSimpleCurve) : sizeof(FRichCurve));
+		Counter.HeapBytes += RowMap.GetAllocatedSize();
+
+		for (const TPair<FName, FRealCurve*>& Row : RowMap)
+		{
+			Counter.AddName(Row.Key);
+			Counter.HeapBytes += static_cast<int64>(Row.Value->GetNumKeys()) * (bSimpleCurves ? sizeof(FSimpleCurveKey) : sizeof(FRichCurveKey));
+		}
+	}
+
+	Entry.HeapBytes = Counter.HeapBytes;
+	Entry.NameTextBytes = Counter.NameTextBytes;
+	return Entry;
+}
+
+TArray<FFPTableMemoryEntry> FPTableMemoryReport::Build()
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByClass(UDataTable::StaticClass()->GetClassPathName(), Assets, true);
+	AssetRegistry.GetAssetsByClass(UCurveTable::StaticClass()->GetClassPathName(), Assets, true);
+
+	TArray<FFPTableMemoryEntry> Entries;
+	Entries.Reserve(Assets.Num());
+
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (!IsTableClass(AssetData) || AssetData.PackageName.ToString().StartsWith(TEXT("/Engine")))
+		{
+			continue;
+		}
+
+		// never load a table just to measure it
+		const UObject* Table = AssetData.IsAssetLoaded() ? AssetData.FastGetAsset(false) : nullptr;
+
+		FFPTableMemoryEntry& Entry = Table ? Entries.Add_GetRef(Measure(Table)) : Entries.AddDefaulted_GetRef();
+		if (!Table)
+		{
+			Entry.Path = AssetData.GetSoftObjectPath();
+			Entry.ClassName = AssetData.AssetClassPath.GetAssetName();
+		}
+
+		if (const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetData.PackageName))
+		{
+			Entry.DiskBytes = PackageData->DiskSize;
+		}
+	}
+
+	Entries.Sort([](const FFPTableMemoryEntry& A, const FFPTableMemoryEntry& B) { return A.GetCost() > B.GetCost(); });
+	return Entries;
+}
+
+void FPTableMemoryReport::LogReport(const TArray<FFPTableMemoryEntry>& Entries)
+{
+	UE_LOG(LogTemp, Log, TEXT("%-48s %8s %12s %12s %12s %12s %12s %12s"), TEXT("Table"), TEXT("Rows"), TEXT("RowStructs"), TEXT("Heap"), TEXT("Names/Text"), TEXT("Total"), TEXT("Source"), TEXT("Disk"));
+
+	int64 LoadedBytes = 0;
+	for (const FFPTableMemoryEntry& Entry : Entries)
+	{
+		if (!Entry.bLoaded)
+		{
+			UE_LOG(LogTemp, Log, TEXT("%-48s %8s %12s %12s %12s %12s %12s %12lld"), *Entry.Path.GetAssetName(), TEXT("-"), TEXT("-"), TEXT("-"), TEXT("-"), TEXT("-"), TEXT("n/a"), Entry.DiskBytes);
+			continue;
+		}
+
+		LoadedBytes += Entry.GetMemoryBytes();
+		UE_LOG(LogTemp, Log, TEXT("%-48s %8d %12lld %12lld %12lld %12lld %12lld %12lld"),
+			*Entry.Path.GetAssetName(), Entry.NumRows, Entry.RowBytes, Entry.HeapBytes, Entry.NameTextBytes, Entry.GetMemoryBytes(), Entry.SourceBytes, Entry.DiskBytes);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%d tables, loaded tables use %lld bytes"), Entries.Num(), LoadedBytes);
+}
+
+void FPTableMemoryReport::RegisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(NAME_TABLE_MEMORY_TAB, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs&)
+	{
+		return SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab)
+			[
+				SNew(SFPTableMemoryReport)
+			];
+	}))
+	.SetDisplayName(INVTEXT("Table Memory"))
+	.SetTooltipText(INVTEXT("Estimated memory of each DataTable and CurveTable compared to its import source"))
+	.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void FPTableMemoryReport::UnregisterTabSpawner()
+{
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(NAME_TABLE_MEMORY_TAB);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Estimated memory of one DataTable or CurveTable */
+struct FFPTableMemoryEntry
+{
+	FSoftObjectPath Path;
+	FName ClassName;
+
+	/** Unloaded tables are not loaded for the report, only their size on disk is known */
+	bool bLoaded = false;
+
+	int32 NumRows = 0;
+
+	/** Row struct size * rows */
+	int64 RowBytes = 0;
+
+	/** Heap owned by the rows (strings, arrays, sets, maps, curve keys) and the row map itself */
+	int64 HeapBytes = 0;
+
+	/** Unique FName entries and FText data */
+	int64 NameTextBytes = 0;
+
+	int64 DiskBytes = 0;
+
+	/** Size of the CSV/JSON the table was last imported from, 0 when unknown. Only read for loaded tables */
+	int64 SourceBytes = 0;
+
+	int64 GetMemoryBytes() const { return RowBytes + HeapBytes + NameTextBytes; }
+
+	/** What the report is sorted by, the size on disk stands in for unloaded tables */
+	int64 GetCost() const { return bLoaded ? GetMemoryBytes() : DiskBytes; }
+};
+
+namespace FPTableMemoryReport
+{
+	/** Every DataTable (including composites) and CurveTable in the asset registry, most expensive first */
+	TArray<FFPTableMemoryEntry> Build();
+
+	FFPTableMemoryEntry Measure(const UObject* Table);
+
+	void LogReport(const TArray<FFPTableMemoryEntry>& Entries);
+
+	void RegisterTabSpawner();
+	void UnregisterTabSpawner();
+}
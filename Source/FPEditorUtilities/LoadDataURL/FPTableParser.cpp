@@ -0,0 +1,857 @@
+#include "FPTableParser.h"
+
+#include "DataTableUtils.h"
+#include "JsonObjectConverter.h"
+#include "Engine/DataTable.h"
+#include "Serialization/JsonReader.h"
+
+namespace FPTableParser
+{
+	/** Reads one CSV cell at a time. Cells are only copied when the caller asks for them. */
+	class FCSVTokenizer
+	{
+	public:
+		explicit FCSVTokenizer(FStringView InCSV) : CSV(InCSV) {}
+
+		void Reset(FStringView InCSV)
+		{
+			CSV = InCSV;
+			Pos = 0;
+		}
+
+		bool IsAtEnd() const { return Pos >= CSV.Len(); }
+		int32 GetPos() const { return Pos; }
+
+		/**
+		 * Read the next cell, or skip it when OutCell is null.
+		 * The view points into the source text unless the cell had escaped quotes, and is only valid until the next call.
+		 * Returns false once the cell was the last one on its line.
+		 */
+		bool NextCell(FStringView* OutCell)
+		{
+			const TCHAR* Data = CSV.GetData();
+			const int32 Len = CSV.Len();
+
+			if (Pos < Len && Data[Pos] == TEXT('"'))
+			{
+				const int32 Start = ++Pos;
+				bool bHasEscapedQuotes = false;
+				while (Pos < Len)
+				{
+					if (Data[Pos] == TEXT('"'))
+					{
+						if (Pos + 1 < Len && Data[Pos + 1] == TEXT('"'))
+						{
+							bHasEscapedQuotes = true;
+							Pos += 2;
+							continue;
+						}
+						break;
+					}
+					++Pos;
+				}
+
+				const int32 End = Pos;
+				if (OutCell)
+				{
+					if (bHasEscapedQuotes)
+					{
+						Scratch.Reset();
+						Scratch.Append(Data + Start, End - Start);
+						Scratch.ReplaceInline(TEXT("\"\""), TEXT("\""));
+						*OutCell = Scratch;
+					}
+					else
+					{
+						*OutCell = FStringView(Data + Start, End - Start);
+					}
+				}
+
+				// step over the closing quote and anything before the next delimiter
+				while (Pos < Len && !IsDelimiter(Data[Pos]))
+				{
+					++Pos;
+				}
+			}
+			else
+			{
+				const int32 Start = Pos;
+				while (Pos < Len && !IsDelimiter(Data[Pos]))
+				{
+					++Pos;
+				}
+
+				if (OutCell)
+				{
+					*OutCell = FStringView(Data + Start, Pos - Start);
+				}
+			}
+
+			return ConsumeDelimiter();
+		}
+
+		void SkipLine(bool bMoreCells)
+		{
+			while (bMoreCells)
+			{
+				bMoreCells = NextCell(nullptr);
+			}
+		}
+
+	private:
+		static bool IsDelimiter(TCHAR Char)
+		{
+			return Char == TEXT(',') || Char == TEXT('\n') || Char == TEXT('\r');
+		}
+
+		bool ConsumeDelimiter()
+		{
+			const TCHAR* Data = CSV.GetData();
+			const int32 Len = CSV.Len();
+
+			if (Pos >= Len)
+			{
+				return false;
+			}
+
+			if (Data[Pos] == TEXT(','))
+			{
+				++Pos;
+				return true;
+			}
+
+			if (Data[Pos] == TEXT('\r'))
+			{
+				++Pos;
+			}
+
+			if (Pos < Len && Data[Pos] == TEXT('\n'))
+			{
+				++Pos;
+			}
+
+			return false;
+		}
+
+		FStringView CSV;
+		int32 Pos = 0;
+		FString Scratch;
+	};
+
+	static FProperty* FindPropertyByImportName(const UScriptStruct* RowStruct, FStringView Name)
+	{
+		TArray<FString> ImportNames;
+		for (TFieldIterator<FProperty> It(RowStruct); It; ++It)
+		{
+			ImportNames.Reset();
+			DataTableUtils::GetPropertyImportNames(*It, ImportNames);
+			for (const FString& ImportName : ImportNames)
+			{
+				if (Name.Equals(ImportName, ESearchCase::IgnoreCase))
+				{
+					return *It;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	static FProperty* FindColumnProperty(const UScriptStruct* RowStruct, const FFPColumnMapping& Mapping, FStringView ColumnName)
+	{
+		ColumnName.TrimStartAndEndInline();
+
+		if (Mapping.IsEmpty())
+		{
+			return FindPropertyByImportName(RowStruct, ColumnName);
+		}
+
+		for (const TPair<FString, FString>& Column : Mapping.Columns)
+		{
+			if (ColumnName.Equals(Column.Key, ESearchCase::IgnoreCase))
+			{
+				return FindPropertyByImportName(RowStruct, Column.Value);
+			}
+		}
+
+		return nullptr;
+	}
+}
+
+FFPColumnMapping FFPColumnMapping::Parse(const FString& MappingString)
+{
+	FFPColumnMapping Mapping;
+
+	TArray<FString> Entries;
+	MappingString.ParseIntoArray(Entries, TEXT(","), true);
+
+	for (FString& Entry : Entries)
+	{
+		FString Source;
+		FString Property;
+		if (!Entry.Split(TEXT("="), &Source, &Property))
+		{
+			Source = Entry;
+			Property = Entry;
+		}
+
+		Source.TrimStartAndEndInline();
+		Property.TrimStartAndEndInline();
+
+		if (!Source.IsEmpty() && !Property.IsEmpty())
+		{
+			Mapping.Columns.Emplace(MoveTemp(Source), MoveTemp(Property));
+		}
+	}
+
+	return Mapping;
+}
+
+FFPParsedRows::FFPParsedRows(const UScriptStruct* InRowStruct)
+	: RowStruct(InRowStruct)
+{
+}
+
+FFPParsedRows::~FFPParsedRows()
+{
+	for (uint8* Row : RowData)
+	{
+		RowStruct->DestroyStruct(Row);
+		FMemory::Free(Row);
+	}
+}
+
+uint8* FFPParsedRows::AddRow(FName RowName)
+{
+	uint8* Row = AllocateRow();
+	AddRow(RowName, Row);
+	return Row;
+}
+
+uint8* FFPParsedRows::AllocateRow() const
+{
+	uint8* Row = static_cast<uint8*>(FMemory::Malloc(RowStruct->GetStructureSize(), RowStruct->GetMinAlignment()));
+	RowStruct->InitializeStruct(Row);
+	return Row;
+}
+
+void FFPParsedRows::AddRow(FName RowName, uint8* Row)
+{
+	RowNames.Add(RowName);
+	RowData.Add(Row);
+
+	if (Progress)
+	{
+		++Progress->RowsParsed;
+	}
+}
+
+void FFPParsedRows::FreeRow(uint8* Row) const
+{
+	RowStruct->DestroyStruct(Row);
+	FMemory::Free(Row);
+}
+
+TArray<FName> FFPParsedRows::MergeFrom(FFPParsedRows& Other, bool bOtherWins)
+{
+	check(Other.RowStruct == RowStruct);
+
+	TMap<FName, int32> RowIndices;
+	RowIndices.Reserve(RowNames.Num() + Other.RowNames.Num());
+	for (int32 Index = 0; Index < RowNames.Num(); ++Index)
+	{
+		RowIndices.Add(RowNames[Index], Index);
+	}
+
+	// whether Other's row holds each of its names. within Other the last row of a name is kept, like a single source import
+	TMap<FName, bool> OtherRowKept;
+	OtherRowKept.Reserve(Other.RowNames.Num());
+
+	TArray<FName> Conflicts;
+	for (int32 Index = 0; Index < Other.RowNames.Num(); ++Index)
+	{
+		const FName RowName = Other.RowNames[Index];
+		uint8* Row = Other.RowData[Index];
+
+		if (const bool* bKept = OtherRowKept.Find(RowName))
+		{
+			Problems.Add(FString::Printf(TEXT("Duplicate row name '%s' in one source, the last one is kept"), *RowName.ToString()));
+
+			const int32 ExistingIndex = RowIndices.FindChecked(RowName);
+			if (*bKept)
+			{
+				FreeRow(RowData[ExistingIndex]);
+				RowData[ExistingIndex] = Row;
+			}
+			else
+			{
+				FreeRow(Row);
+			}
+			continue;
+		}
+
+		if (const int32* ExistingIndex = RowIndices.Find(RowName))
+		{
+			Conflicts.Add(RowName);
+			OtherRowKept.Add(RowName, bOtherWins);
+			if (bOtherWins)
+			{
+				FreeRow(RowData[*ExistingIndex]);
+				RowData[*ExistingIndex] = Row;
+			}
+			else
+			{
+				FreeRow(Row);
+			}
+			continue;
+		}
+
+		OtherRowKept.Add(RowName, true);
+		RowIndices.Add(RowName, RowNames.Num());
+		RowNames.Add(RowName);
+		RowData.Add(Row);
+	}
+
+	// the row memory belongs to these rows now
+	Other.RowNames.Reset();
+	Other.RowData.Reset();
+	Problems.Append(MoveTemp(Other.Problems));
+
+	return Conflicts;
+}
+
+void FFPParsedRows::ApplyTo(UDataTable* DataTable)
+{
+	if (DataTable->GetRowStruct() != RowStruct)
+	{
+		Problems.Add(FString::Printf(TEXT("Row struct of %s changed while importing"), *DataTable->GetName()));
+		return;
+	}
+
+	DataTable->Modify();
+	DataTable->EmptyTable();
+
+	for (int32 Index = 0; Index < RowNames.Num(); ++Index)
+	{
+		if (DataTable->GetRowMap().Contains(RowNames[Index]))
+		{
+			Problems.Add(FString::Printf(TEXT("Duplicate row name '%s', the last one is kept"), *RowNames[Index].ToString()));
+		}
+
+		DataTable->AddRow(RowNames[Index], *reinterpret_cast<const FTableRowBase*>(RowData[Index]));
+	}
+
+	for (const TPair<FName, uint8*>& Row : DataTable->GetRowMap())
+	{
+		reinterpret_cast<FTableRowBase*>(Row.Value)->OnPostDataImport(DataTable, Row.Key, Problems);
+	}
+}
+
+namespace FPTableParser
+{
+	/** Resolve each header column to a property once, unmapped columns stay null and are skipped by ParseRecord */
+	static TArray<FProperty*> ParseHeader(FCSVTokenizer& Tokenizer, const UScriptStruct* RowStruct, const FFPColumnMapping& Mapping)
+	{
+		TArray<FProperty*> ColumnProperties;
+		bool bMoreCells = !Tokenizer.IsAtEnd();
+		while (bMoreCells)
+		{
+			FStringView Cell;
+			bMoreCells = Tokenizer.NextCell(&Cell);
+			ColumnProperties.Add(ColumnProperties.IsEmpty() ? nullptr : FindColumnProperty(RowStruct, Mapping, Cell));
+		}
+
+		return ColumnProperties;
+	}
+
+	static void ParseRecord(FCSVTokenizer& Tokenizer, const TArray<FProperty*>& ColumnProperties, FString& Value, FFPParsedRows& OutRows)
+	{
+		FStringView Cell;
+		bool bMoreCells = Tokenizer.NextCell(&Cell);
+
+		if (Cell.IsEmpty())
+		{
+			Tokenizer.SkipLine(bMoreCells);
+			return;
+		}
+
+		const FName RowName = DataTableUtils::MakeValidName(FString(Cell));
+		uint8* Row = OutRows.AddRow(RowName);
+
+		for (int32 Column = 1; bMoreCells; ++Column)
+		{
+			FProperty* Property = ColumnProperties.IsValidIndex(Column) ? ColumnProperties[Column] : nullptr;
+			bMoreCells = Tokenizer.NextCell(Property ? &Cell : nullptr);
+
+			if (Property)
+			{
+				Value.Reset();
+				Value.Append(Cell.GetData(), Cell.Len());
+
+				const FString Error = DataTableUtils::AssignStringToProperty(Value, Property, Row);
+				if (!Error.IsEmpty())
+				{
+					OutRows.Problems.Add(FString::Printf(TEXT("Row '%s' property '%s': %s"), *RowName.ToString(), *Property->GetName(), *Error));
+				}
+			}
+		}
+	}
+
+	static bool CanParsePropertyOffGameThread(const FProperty* Property)
+	{
+		if (Property->IsA<FObjectProperty>() || Property->IsA<FWeakObjectProperty>() || Property->IsA<FLazyObjectProperty>() || Property->IsA<FInterfaceProperty>())
+		{
+			return false;
+		}
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			return CanParseOffGameThread(StructProperty->Struct);
+		}
+
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			return CanParsePropertyOffGameThread(ArrayProperty->Inner);
+		}
+
+		if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			return CanParsePropertyOffGameThread(SetProperty->ElementProp);
+		}
+
+		if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			return CanParsePropertyOffGameThread(MapProperty->KeyProp) && CanParsePropertyOffGameThread(MapProperty->ValueProp);
+		}
+
+		return true;
+	}
+}
+
+void FPTableParser::ParseCSV(FStringView CSV, const FFPColumnMapping& Mapping, FFPParsedRows& OutRows)
+{
+	if (!OutRows.RowStruct)
+	{
+		OutRows.Problems.Add(TEXT("Missing row struct"));
+		return;
+	}
+
+	FCSVTokenizer Tokenizer(CSV);
+	const TArray<FProperty*> ColumnProperties = ParseHeader(Tokenizer, OutRows.RowStruct, Mapping);
+
+	FString Value;
+	while (!Tokenizer.IsAtEnd() && !OutRows.IsCancelled())
+	{
+		ParseRecord(Tokenizer, ColumnProperties, Value, OutRows);
+	}
+}
+
+FStringView FPTableParser::GetHeader(FStringView CSV)
+{
+	FCSVTokenizer Tokenizer(CSV);
+	Tokenizer.SkipLine(!Tokenizer.IsAtEnd());
+
+	int32 End = Tokenizer.GetPos();
+	while (End > 0 && (CSV[End - 1] == TEXT('\n') || CSV[End - 1] == TEXT('\r')))
+	{
+		--End;
+	}
+	return CSV.Left(End);
+}
+
+void FPTableParser::ParseCSVBody(FStringView Header, FStringView Body, const FFPColumnMapping& Mapping, FFPParsedRows& OutRows)
+{
+	if (!OutRows.RowStruct)
+	{
+		OutRows.Problems.Add(TEXT("Missing row struct"));
+		return;
+	}
+
+	FCSVTokenizer Tokenizer(Header);
+	const TArray<FProperty*> ColumnProperties = ParseHeader(Tokenizer, OutRows.RowStruct, Mapping);
+
+	Tokenizer.Reset(Body);
+
+	FString Value;
+	while (!Tokenizer.IsAtEnd() && !OutRows.IsCancelled())
+	{
+		ParseRecord(Tokenizer, ColumnProperties, Value, OutRows);
+	}
+}
+
+void FPTableParser::SplitRecords(FStringView CSV, FStringView& OutHeader, TArray<FFPCSVRecord>& OutRecords)
+{
+	FCSVTokenizer Tokenizer(CSV);
+
+	auto TrimLineEnd = [&CSV](int32 Start, int32 End)
+	{
+		while (End > Start && (CSV[End - 1] == TEXT('\n') || CSV[End - 1] == TEXT('\r')))
+		{
+			--End;
+		}
+		return CSV.Mid(Start, End - Start);
+	};
+
+	Tokenizer.SkipLine(!Tokenizer.IsAtEnd());
+	OutHeader = TrimLineEnd(0, Tokenizer.GetPos());
+
+	while (!Tokenizer.IsAtEnd())
+	{
+		const int32 Start = Tokenizer.GetPos();
+
+		FStringView Cell;
+		const bool bMoreCells = Tokenizer.NextCell(&Cell);
+		FString RowName(Cell);
+		Tokenizer.SkipLine(bMoreCells);
+
+		if (!RowName.IsEmpty())
+		{
+			OutRecords.Add({ TrimLineEnd(Start, Tokenizer.GetPos()), MoveTemp(RowName) });
+		}
+	}
+}
+
+void FPTableParser::ParseRecords(FStringView Header, TConstArrayView<FFPCSVRecord> Records, const FFPColumnMapping& Mapping, FFPParsedRows& OutRows)
+{
+	if (!OutRows.RowStruct)
+	{
+		OutRows.Problems.Add(TEXT("Missing row struct"));
+		return;
+	}
+
+	FCSVTokenizer Tokenizer(Header);
+	const TArray<FProperty*> ColumnProperties = ParseHeader(Tokenizer, OutRows.RowStruct, Mapping);
+
+	FString Value;
+	for (const FFPCSVRecord& Record : Records)
+	{
+		if (OutRows.IsCancelled())
+		{
+			return;
+		}
+
+		Tokenizer.Reset(Record.Text);
+		ParseRecord(Tokenizer, ColumnProperties, Value, OutRows);
+	}
+}
+
+namespace FPTableParser
+{
+	using FJsonPullReader = TJsonReader<TCHAR>;
+
+	static bool ReadScalar(FJsonPullReader& Reader, EJsonNotation Notation, FString& OutValue)
+	{
+		switch (Notation)
+		{
+			case EJsonNotation::String:
+				OutValue = Reader.GetValueAsString();
+				return true;
+			case EJsonNotation::Number:
+			{
+				// integers keep their digits, a double only holds them exactly up to 2^53
+				const FString& Token = Reader.GetValueAsNumberString();
+				int32 Index;
+				const bool bIsInteger = !Token.FindChar(TEXT('.'), Index) && !Token.FindChar(TEXT('e'), Index) && !Token.FindChar(TEXT('E'), Index);
+				OutValue = bIsInteger ? Token : FString::SanitizeFloat(Reader.GetValueAsNumber(), 0);
+				return true;
+			}
+			case EJsonNotation::Boolean:
+				OutValue = Reader.GetValueAsBoolean() ? TEXT("true") : TEXT("false");
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/** Build the json value for a single nested cell, the reader is positioned on its first token */
+	static TSharedPtr<FJsonValue> ReadNestedValue(FJsonPullReader& Reader, EJsonNotation Notation)
+	{
+		switch (Notation)
+		{
+			case EJsonNotation::String:
+				return MakeShared<FJsonValueString>(Reader.GetValueAsString());
+			case EJsonNotation::Number:
+				return MakeShared<FJsonValueNumberString>(Reader.GetValueAsNumberString());
+			case EJsonNotation::Boolean:
+				return MakeShared<FJsonValueBoolean>(Reader.GetValueAsBoolean());
+			case EJsonNotation::Null:
+				return MakeShared<FJsonValueNull>();
+			case EJsonNotation::ArrayStart:
+			{
+				TArray<TSharedPtr<FJsonValue>> Values;
+				while (Reader.ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd)
+				{
+					Values.Add(ReadNestedValue(Reader, Notation));
+				}
+				return MakeShared<FJsonValueArray>(Values);
+			}
+			case EJsonNotation::ObjectStart:
+			{
+				TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+				while (Reader.ReadNext(Notation) && Notation != EJsonNotation::ObjectEnd)
+				{
+					const FString Identifier = Reader.GetIdentifier();
+					Object->SetField(Identifier, ReadNestedValue(Reader, Notation));
+				}
+				return MakeShared<FJsonValueObject>(Object);
+			}
+			default:
+				return nullptr;
+		}
+	}
+
+	/** Write one value into the row, values without a property are skipped by the reader without being built */
+	static void ReadCell(FJsonPullReader& Reader, EJsonNotation Notation, FProperty* Property, uint8* Row, FName RowName, FString& Value, FFPParsedRows& OutRows)
+	{
+		if (!Property)
+		{
+			if (Notation == EJsonNotation::ObjectStart)
+			{
+				Reader.SkipObject();
+			}
+			else if (Notation == EJsonNotation::ArrayStart)
+			{
+				Reader.SkipArray();
+			}
+			return;
+		}
+
+		FString Error;
+		if (ReadScalar(Reader, Notation, Value))
+		{
+			Error = DataTableUtils::AssignStringToProperty(Value, Property, Row);
+		}
+		else if (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)
+		{
+			const TSharedPtr<FJsonValue> JsonValue = ReadNestedValue(Reader, Notation);
+			if (!JsonValue.IsValid() || !FJsonObjectConverter::JsonValueToUProperty(JsonValue, Property, Property->ContainerPtrToValuePtr<void>(Row)))
+			{
+				Error = TEXT("Failed to convert the JSON value");
+			}
+		}
+
+		if (!Error.IsEmpty())
+		{
+			OutRows.Problems.Add(FString::Printf(TEXT("Row '%s' property '%s': %s"), *RowName.ToString(), *Property->GetName(), *Error));
+		}
+	}
+
+	struct FJsonParseContext
+	{
+		const FFPColumnMapping& Mapping;
+		FFPParsedRows& OutRows;
+		TMap<FString, FProperty*> FieldProperties;
+		FString Value;
+
+		FProperty* FindFieldProperty(const FString& FieldName)
+		{
+			if (FProperty** Found = FieldProperties.Find(FieldName))
+			{
+				return *Found;
+			}
+
+			return FieldProperties.Add(FieldName, FindColumnProperty(OutRows.RowStruct, Mapping, FieldName));
+		}
+	};
+
+	/** Sheets API "values": an array of rows of cells, the first row is the header */
+	static void ReadValueRows(FJsonPullReader& Reader, FJsonParseContext& Context)
+	{
+		TArray<FProperty*> ColumnProperties;
+		bool bIsHeader = true;
+
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation) && Notation == EJsonNotation::ArrayStart && !Context.OutRows.IsCancelled())
+		{
+			uint8* Row = nullptr;
+			FName RowName;
+
+			for (int32 Column = 0; Reader.ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd; ++Column)
+			{
+				if (bIsHeader)
+				{
+					const bool bIsName = ReadScalar(Reader, Notation, Context.Value);
+					ColumnProperties.Add(bIsName && Column > 0 ? FindColumnProperty(Context.OutRows.RowStruct, Context.Mapping, Context.Value) : nullptr);
+					ReadCell(Reader, Notation, nullptr, nullptr, NAME_None, Context.Value, Context.OutRows);
+				}
+				else if (Column == 0)
+				{
+					if (!ReadScalar(Reader, Notation, Context.Value) || Context.Value.IsEmpty())
+					{
+						// rows without a name are skipped like in the CSV
+						ReadCell(Reader, Notation, nullptr, nullptr, NAME_None, Context.Value, Context.OutRows);
+						Reader.SkipArray();
+						break;
+					}
+
+					RowName = DataTableUtils::MakeValidName(Context.Value);
+					Row = Context.OutRows.AddRow(RowName);
+				}
+				else
+				{
+					FProperty* Property = ColumnProperties.IsValidIndex(Column) ? ColumnProperties[Column] : nullptr;
+					ReadCell(Reader, Notation, Property, Row, RowName, Context.Value, Context.OutRows);
+				}
+			}
+
+			bIsHeader = false;
+		}
+	}
+
+	/** A row object, or at the root of a Sheets API response the object holding the value rows */
+	static void ReadRowObject(FJsonPullReader& Reader, FJsonParseContext& Context, bool bIsRoot)
+	{
+		static const FString NameField = TEXT("Name");
+		static const FString ValuesField = TEXT("values");
+
+		// the name may come after the values, so the row is only added once the object is complete
+		uint8* Row = Context.OutRows.AllocateRow();
+		FName RowName;
+		bool bHadValueRows = false;
+
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation) && Notation != EJsonNotation::ObjectEnd)
+		{
+			const FString& Identifier = Reader.GetIdentifier();
+			// ids are often numbers, which name the row like their text would
+			if ((Notation == EJsonNotation::String || Notation == EJsonNotation::Number) && Identifier.Equals(NameField, ESearchCase::IgnoreCase))
+			{
+				ReadScalar(Reader, Notation, Context.Value);
+				RowName = DataTableUtils::MakeValidName(Context.Value);
+			}
+			else if (bIsRoot && Notation == EJsonNotation::ArrayStart && Identifier == ValuesField)
+			{
+				ReadValueRows(Reader, Context);
+				bHadValueRows = true;
+			}
+			else
+			{
+				ReadCell(Reader, Notation, Context.FindFieldProperty(Identifier), Row, RowName, Context.Value, Context.OutRows);
+			}
+		}
+
+		if (bHadValueRows || RowName.IsNone())
+		{
+			if (!bHadValueRows)
+			{
+				Context.OutRows.Problems.Add(TEXT("Skipped a row object without a \"Name\" field"));
+			}
+
+			Context.OutRows.FreeRow(Row);
+			return;
+		}
+
+		Context.OutRows.AddRow(RowName, Row);
+	}
+
+	static void ParseJSONDocument(FStringView JSON, FJsonParseContext& Context)
+	{
+		TSharedRef<FJsonPullReader> Reader = TJsonReaderFactory<TCHAR>::CreateFromView(JSON);
+
+		EJsonNotation Notation;
+		if (!Reader->ReadNext(Notation))
+		{
+			Context.OutRows.Problems.Add(FString::Printf(TEXT("Invalid JSON: %s"), *Reader->GetErrorMessage()));
+			return;
+		}
+
+		if (Notation == EJsonNotation::ObjectStart)
+		{
+			ReadRowObject(*Reader, Context, true);
+		}
+		else if (Notation == EJsonNotation::ArrayStart)
+		{
+			while (Reader->ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd && !Context.OutRows.IsCancelled())
+			{
+				if (Notation == EJsonNotation::ObjectStart)
+				{
+					ReadRowObject(*Reader, Context, false);
+				}
+				else
+				{
+					Context.OutRows.Problems.Add(TEXT("Expected an array of row objects"));
+					ReadCell(*Reader, Notation, nullptr, nullptr, NAME_None, Context.Value, Context.OutRows);
+				}
+			}
+		}
+
+		if (Notation == EJsonNotation::Error)
+		{
+			Context.OutRows.Problems.Add(FString::Printf(TEXT("Invalid JSON: %s"), *Reader->GetErrorMessage()));
+		}
+	}
+
+	static FStringView SkipLeadingWhitespace(FStringView Text)
+	{
+		int32 Start = 0;
+		while (Start < Text.Len() && (FChar::IsWhitespace(Text[Start]) || Text[Start] == TCHAR(0xFEFF)))
+		{
+			++Start;
+		}
+		return Text.RightChop(Start);
+	}
+}
+
+void FPTableParser::ParseJSON(FStringView JSON, const FFPColumnMapping& Mapping, FFPParsedRows& OutRows)
+{
+	if (!OutRows.RowStruct)
+	{
+		OutRows.Problems.Add(TEXT("Missing row struct"));
+		return;
+	}
+
+	FJsonParseContext Context{ Mapping, OutRows };
+
+	JSON = SkipLeadingWhitespace(JSON);
+
+	// json lines: every line is a complete object, otherwise the whole text is one document
+	int32 FirstLineEnd = INDEX_NONE;
+	const bool bHasMoreLines = JSON.FindChar(TEXT('\n'), FirstLineEnd);
+	const bool bIsJSONLines = bHasMoreLines && JSON.StartsWith(TEXT('{')) && JSON.Left(FirstLineEnd).TrimEnd().EndsWith(TEXT('}'));
+	if (!bIsJSONLines)
+	{
+		ParseJSONDocument(JSON, Context);
+		return;
+	}
+
+	while (!JSON.IsEmpty() && !OutRows.IsCancelled())
+	{
+		int32 LineEnd = INDEX_NONE;
+		if (!JSON.FindChar(TEXT('\n'), LineEnd))
+		{
+			LineEnd = JSON.Len();
+		}
+
+		const FStringView Line = JSON.Left(LineEnd).TrimStartAndEnd();
+		if (!Line.IsEmpty())
+		{
+			ParseJSONDocument(Line, Context);
+		}
+
+		JSON.RightChopInline(LineEnd + 1);
+	}
+}
+
+bool FPTableParser::LooksLikeJSON(FStringView Text)
+{
+	Text = SkipLeadingWhitespace(Text);
+	return Text.StartsWith(TEXT('[')) || Text.StartsWith(TEXT('{'));
+}
+
+bool FPTableParser::CanParseOffGameThread(const UScriptStruct* RowStruct)
+{
+	if (!RowStruct)
+	{
+		return false;
+	}
+
+	for (TFieldIterator<FProperty> It(RowStruct); It; ++It)
+	{
+		if (!CanParsePropertyOffGameThread(*It))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+class UDataTable;
+
+/** Which source columns feed which row struct properties, parsed from "Source=Property, Other" (a bare name maps to itself) */
+struct FFPColumnMapping
+{
+	TArray<TPair<FString, FString>> Columns;
+
+	static FFPColumnMapping Parse(const FString& MappingString);
+
+	bool IsEmpty() const { return Columns.IsEmpty(); }
+};
+
+/** Shared between an import and the worker parsing it */
+struct FFPImportProgress
+{
+	std::atomic<bool> bCancelled = false;
+	std::atomic<int32> RowsParsed = 0;
+};
+
+/** Row structs parsed outside of a data table, applied to the table in one go */
+struct FFPParsedRows
+{
+	explicit FFPParsedRows(const UScriptStruct* InRowStruct);
+	~FFPParsedRows();
+
+	FFPParsedRows(const FFPParsedRows&) = delete;
+	FFPParsedRows& operator=(const FFPParsedRows&) = delete;
+
+	/** Allocate and initialize a new row, returns the row memory */
+	uint8* AddRow(FName RowName);
+
+	/** Row memory which isn't part of the rows yet (e.g. until its name is known), hand it to AddRow or FreeRow */
+	uint8* AllocateRow() const;
+	void AddRow(FName RowName, uint8* Row);
+	void FreeRow(uint8* Row) const;
+
+	/**
+	 * Move the rows of Other into these rows. A row name which is already here is a conflict, the row from Other
+	 * replaces the existing one when bOtherWins, otherwise it is dropped. Returns the conflicting row names, a name
+	 * repeated within Other is not a conflict but a duplicate, which is added to Problems.
+	 */
+	TArray<FName> MergeFrom(FFPParsedRows& Other, bool bOtherWins);
+
+	/** Replace the contents of the table with these rows */
+	void ApplyTo(UDataTable* DataTable);
+
+	int32 Num() const { return RowNames.Num(); }
+
+	bool IsCancelled() const { return Progress && Progress->bCancelled; }
+
+	const UScriptStruct* RowStruct = nullptr;
+
+	/** Optional, counts parsed rows and stops parsing once cancelled */
+	FFPImportProgress* Progress = nullptr;
+
+	TArray<FName> RowNames;
+	TArray<uint8*> RowData;
+	TArray<FString> Problems;
+};
+
+/** One CSV row (which may span several lines when a cell is quoted) without its line terminator */
+struct FFPCSVRecord
+{
+	FStringView Text;
+	FString RowName;
+};
+
+namespace FPTableParser
+{
+	/**
+	 * Parse CSV text straight into row structs.
+	 * The first column is the row name, the first line is the header. Columns which are not in the mapping
+	 * (or do not match a property when the mapping is empty) are skipped by the tokenizer and never copied.
+	 */
+	void ParseCSV(FStringView CSV, const FFPColumnMapping& Mapping, FFPParsedRows& OutRows);
+
+	/** The first line of CSV text, the view points into CSV */
+	FStringView GetHeader(FStringView CSV);
+
+	/** Parse CSV rows without a header line (e.g. a range of rows) against the header of the first range */
+	void ParseCSVBody(FStringView Header, FStringView Body, const FFPColumnMapping& Mapping, FFPParsedRows& OutRows);
+
+	/** Split CSV text into its header and row records, the views point into CSV */
+	void SplitRecords(FStringView CSV, FStringView& OutHeader, TArray<FFPCSVRecord>& OutRecords);
+
+	/** Parse a subset of the records from SplitRecords against their header */
+	void ParseRecords(FStringView Header, TConstArrayView<FFPCSVRecord> Records, const FFPColumnMapping& Mapping, FFPParsedRows& OutRows);
+
+	/**
+	 * Parse JSON text straight into row structs with a pull reader, no document tree is built for the payload.
+	 * Accepts an array of row objects (the DataTable JSON export format, the row name is the "Name" field), JSON Lines
+	 * with one row object per line, or a Sheets API response whose "values" are rows of cells with a header row.
+	 * Only nested values (structs, arrays, maps) are materialized, one cell at a time.
+	 */
+	void ParseJSON(FStringView JSON, const FFPColumnMapping& Mapping, FFPParsedRows& OutRows);
+
+	/** The first character is an array or object */
+	bool LooksLikeJSON(FStringView Text);
+
+	/** Hard object references are resolved while parsing, which is only safe on the game thread */
+	bool CanParseOffGameThread(const UScriptStruct* RowStruct);
+}
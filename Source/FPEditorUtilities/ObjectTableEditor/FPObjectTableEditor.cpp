@@ -14,6 +14,8 @@
 #include "Editor/PropertyEditor/Private/PropertyNode.h"
 #include "Factories/BlueprintFactory.h"
 #include "Factories/DataAssetFactory.h"
+#include "Widgets/Colors/SColorBlock.h"
+#include "Widgets/Images/SThrobber.h"
 #include "Widgets/Text/SInlineEditableTextBlock.h"
 #include "Filters/SAssetFilterBar.h"
 #include "Framework/Notifications/NotificationManager.h"
@@ -21,10 +23,8 @@
 #include "Misc/TransactionObjectEvent.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
-UObject* FFPObjectData::GetObj()
+static UObject* GetTableObject(UObject* Obj)
 {
-	UObject* Obj = AssetData.GetAsset();
-
 	if (UBlueprint* BP = Cast<UBlueprint>(Obj))
 	{
 		if (BP->GeneratedClass)
@@ -36,6 +36,89 @@ UObject* FFPObjectData::GetObj()
 	return Obj;
 }
 
+UObject* FFPObjectData::GetObj()
+{
+	return GetTableObject(AssetData.GetAsset());
+}
+
+UObject* FFPObjectData::GetLoadedObj() const
+{
+	return GetTableObject(AssetData.FastGetAsset(false));
+}
+
+void FFPPropertyChangeDispatcher::Start()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddSP(this, &FFPPropertyChangeDispatcher::HandleObjectPropertyChanged);
+	FCoreUObjectDelegates::OnObjectTransacted.AddSP(this, &FFPPropertyChangeDispatcher::HandleObjectTransacted);
+}
+
+FFPPropertyChangeDispatcher::~FFPPropertyChangeDispatcher()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+}
+
+void FFPPropertyChangeDispatcher::Add(const UObject* Object, FName PropertyName, FSimpleDelegate OnChanged)
+{
+	Listeners.FindOrAdd(Object).Add({ PropertyName, MoveTemp(OnChanged) });
+}
+
+void FFPPropertyChangeDispatcher::RemoveExpired(const UObject* Object)
+{
+	if (TArray<FListener>* ObjectListeners = Listeners.Find(Object))
+	{
+		ObjectListeners->RemoveAll([](const FListener& Listener) { return !Listener.OnChanged.IsBound(); });
+		if (ObjectListeners->IsEmpty())
+		{
+			Listeners.Remove(Object);
+		}
+	}
+}
+
+void FFPPropertyChangeDispatcher::Notify(const UObject* Object, FName PropertyName)
+{
+	const TArray<FListener>* ObjectListeners = Listeners.Find(Object);
+	if (!ObjectListeners)
+	{
+		return;
+	}
+
+	// copied, a cell may be made or removed while syncing
+	for (const FListener& Listener : TArray<FListener>(*ObjectListeners))
+	{
+		if (PropertyName.IsNone() || Listener.PropertyName == PropertyName)
+		{
+			Listener.OnChanged.ExecuteIfBound();
+		}
+	}
+}
+
+void FFPPropertyChangeDispatcher::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& ChangeEvent)
+{
+	// a change inside a struct is a change of the column's property
+	Notify(Object, ChangeEvent.MemberProperty ? ChangeEvent.MemberProperty->GetFName() : ChangeEvent.GetPropertyName());
+}
+
+void FFPPropertyChangeDispatcher::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionObjectEvent)
+{
+	if (!Listeners.Contains(Object))
+	{
+		return;
+	}
+
+	const TArray<FName>& ChangedProperties = TransactionObjectEvent.GetChangedProperties();
+	if (ChangedProperties.IsEmpty())
+	{
+		Notify(Object, NAME_None);
+		return;
+	}
+
+	for (FName PropertyName : ChangedProperties)
+	{
+		Notify(Object, PropertyName);
+	}
+}
+
 void SFPPropertyValueContainer::Construct(const FArguments& InArgs, UObject* InObj, FProperty* InProperty)
 {
 	Obj = InObj;
@@ -96,8 +179,12 @@ void SFPPropertyText::Construct(const FArguments& InArgs, UObject* InObj, FPrope
 {
 	Obj = InObj;
 	Prop = InProperty;
-	FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &SFPPropertyText::HandleObjectPropertyChanged);
-	FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &SFPPropertyText::HandleObjectTransacted);
+	Dispatcher = InArgs._Dispatcher;
+
+	if (InArgs._Dispatcher)
+	{
+		InArgs._Dispatcher->Add(Obj, Prop->GetFName(), FSimpleDelegate::CreateSP(this, &SFPPropertyText::SyncPropertyText));
+	}
 
 	ChildSlot
 	[
@@ -109,8 +196,10 @@ void SFPPropertyText::Construct(const FArguments& InArgs, UObject* InObj, FPrope
 
 SFPPropertyText::~SFPPropertyText()
 {
-	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
-	FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &SFPPropertyText::HandleObjectTransacted);
+	if (TSharedPtr<FFPPropertyChangeDispatcher> PinnedDispatcher = Dispatcher.Pin())
+	{
+		PinnedDispatcher->RemoveExpired(Obj);
+	}
 }
 
 void SFPPropertyText::SyncPropertyText()
@@ -145,27 +234,171 @@ void SFPPropertyText::HandleTextCommitted(const FText& Text, ETextCommit::Type A
 	}
 }
 
-void SFPPropertyText::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& ChangeEvent)
+FReply SFPPropertyText::OnMouseButtonDoubleClick(const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent)
 {
-	if (Obj == Object && ChangeEvent.Property == Prop)
+	if (EditableTextBlock->IsHovered())
 	{
-		SyncPropertyText();
+		EditableTextBlock->EnterEditingMode();
+		return FReply::Handled();
 	}
+
+	return FReply::Unhandled();
 }
 
-void SFPPropertyText::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionObjectEvent)
+void SFPPropertyCell::Construct(const FArguments& InArgs, UObject* InObj, FProperty* InProperty, EFPCellRenderer InRenderer, bool bInUseSinglePropertyView)
 {
-	if (Obj == Object && TransactionObjectEvent.GetChangedProperties().Contains(Prop->GetName()))
+	Obj = InObj;
+	Prop = InProperty;
+	Renderer = InRenderer;
+	bUseSinglePropertyView = bInUseSinglePropertyView;
+	Dispatcher = InArgs._Dispatcher;
+
+	if (InArgs._Dispatcher)
 	{
-		SyncPropertyText();
+		InArgs._Dispatcher->Add(Obj, Prop->GetFName(), FSimpleDelegate::CreateSP(this, &SFPPropertyCell::SyncValue));
 	}
+
+	SyncValue();
+
+	ChildSlot
+	[
+		MakeValueWidget()
+	];
 }
 
-FReply SFPPropertyText::OnMouseButtonDoubleClick(const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent)
+SFPPropertyCell::~SFPPropertyCell()
 {
-	if (EditableTextBlock->IsHovered())
+	if (TSharedPtr<FFPPropertyChangeDispatcher> PinnedDispatcher = Dispatcher.Pin())
 	{
-		EditableTextBlock->EnterEditingMode();
+		PinnedDispatcher->RemoveExpired(Obj);
+	}
+}
+
+TSharedRef<SWidget> SFPPropertyCell::MakeValueWidget()
+{
+	switch (Renderer)
+	{
+		case EFPCellRenderer::Bool:
+			return SNew(SImage).Image(this, &SFPPropertyCell::GetBoolBrush);
+		case EFPCellRenderer::Color:
+			return SNew(SBox).HeightOverride(14.0f).VAlign(VAlign_Center)
+				[
+					SNew(SColorBlock).Color(this, &SFPPropertyCell::GetValueColor).ShowBackgroundForAlpha(true)
+				];
+		case EFPCellRenderer::Number:
+			return SNew(STextBlock).Text(this, &SFPPropertyCell::GetValueText).Justification(ETextJustify::Right);
+		default:
+			return SNew(STextBlock).Text(this, &SFPPropertyCell::GetValueText).OverflowPolicy(ETextOverflowPolicy::Ellipsis);
+	}
+}
+
+const FSlateBrush* SFPPropertyCell::GetBoolBrush() const
+{
+	return bValue ? FAppStyle::GetBrush("Icons.Check") : FAppStyle::GetNoBrush();
+}
+
+void SFPPropertyCell::SyncValue()
+{
+	if (bEditing)
+	{
+		return;
+	}
+
+	switch (Renderer)
+	{
+		case EFPCellRenderer::Bool:
+			bValue = CastField<FBoolProperty>(Prop)->GetPropertyValue_InContainer(Obj);
+			break;
+		case EFPCellRenderer::Color:
+			if (CastField<FStructProperty>(Prop)->Struct == TBaseStructure<FColor>::Get())
+			{
+				ValueColor = FLinearColor(*Prop->ContainerPtrToValuePtr<FColor>(Obj));
+			}
+			else
+			{
+				ValueColor = *Prop->ContainerPtrToValuePtr<FLinearColor>(Obj);
+			}
+			break;
+		case EFPCellRenderer::Object:
+			// soft references show their asset name without loading it
+			if (CastField<FSoftObjectProperty>(Prop))
+			{
+				const FSoftObjectPtr& SoftObject = *Prop->ContainerPtrToValuePtr<FSoftObjectPtr>(Obj);
+				ValueText = SoftObject.IsNull() ? INVTEXT("None") : FText::FromString(SoftObject.ToSoftObjectPath().GetAssetName());
+			}
+			else
+			{
+				const UObject* Value = CastField<FObjectPropertyBase>(Prop)->GetObjectPropertyValue_InContainer(Obj);
+				ValueText = Value ? FText::FromName(Value->GetFName()) : INVTEXT("None");
+			}
+			break;
+		default:
+		{
+			FString PropVal;
+			ValueText = FBlueprintEditorUtils::PropertyValueToString(Prop, reinterpret_cast<const uint8*>(Obj), PropVal)
+				? FText::FromString(PropVal)
+				: FText::GetEmpty();
+			break;
+		}
+	}
+}
+
+void SFPPropertyCell::StartEditing(bool bEnterTextEditing)
+{
+	if (bEditing)
+	{
+		return;
+	}
+
+	bEditing = true;
+
+	TSharedPtr<SWidget> Editor;
+	if (bUseSinglePropertyView)
+	{
+		FSinglePropertyParams Params;
+		Params.NamePlacement = EPropertyNamePlacement::Type::Hidden;
+
+		FPropertyEditorModule& EditModule = FModuleManager::Get().GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+		TSharedPtr<ISinglePropertyView> PropWidget = EditModule.CreateSingleProperty(Obj, Prop->GetFName(), Params);
+		if (PropWidget && PropWidget->HasValidProperty())
+		{
+			Editor = PropWidget;
+		}
+	}
+
+	if (!Editor)
+	{
+		TSharedRef<SFPPropertyText> PropertyText = SNew(SFPPropertyText, Obj, Prop).Dispatcher(Dispatcher.Pin());
+		Editor = PropertyText;
+
+		// the text box can only take focus once it is part of the window
+		if (bEnterTextEditing)
+		{
+			RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateLambda([PropertyText](double, float)
+			{
+				PropertyText->EditableTextBlock->EnterEditingMode();
+				return EActiveTimerReturnType::Stop;
+			}));
+		}
+	}
+
+	ChildSlot
+	[
+		Editor.ToSharedRef()
+	];
+}
+
+FReply SFPPropertyCell::OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent)
+{
+	StartEditing(false);
+	return FReply::Unhandled();
+}
+
+FReply SFPPropertyCell::OnMouseButtonDoubleClick(const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent)
+{
+	if (!bEditing)
+	{
+		StartEditing(true);
 		return FReply::Handled();
 	}
 
@@ -174,7 +407,7 @@ FReply SFPPropertyText::OnMouseButtonDoubleClick(const FGeometry& InMyGeometry,
 
 void SFPObjectTableRow::HandleObjPropertyChange(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
 {
-	if (Object != Reference->GetObj())
+	if (Object != Reference->GetLoadedObj())
 	{
 		return;
 	}
@@ -182,85 +415,95 @@ void SFPObjectTableRow::HandleObjPropertyChange(UObject* Object, FPropertyChange
 	PropertyChangedEvent.Property->GetName();
 }
 
-void SFPObjectTableRow::Construct(const FArguments& InArgs, TSharedPtr<FFPObjectData> InReference, const TSharedRef<STableViewBase>& OwnerTable)
+void SFPObjectTableRow::Construct(const FArguments& InArgs, TSharedPtr<FFPObjectData> InReference, TSharedRef<const TArray<FFPColumnDescriptor>> InColumns, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	Reference = InReference;
+	Columns = InColumns;
+	Dispatcher = InArgs._Dispatcher;
+
+	const bool bLoaded = Reference->GetLoadedObj() != nullptr;
+	if (!bLoaded)
+	{
+		Reference->OnLoaded.AddSP(this, &SFPObjectTableRow::HandleObjLoaded);
+	}
+
 	SMultiColumnTableRow::Construct(SMultiColumnTableRow::FArguments(), OwnerTable);
+
+	if (!bLoaded)
+	{
+		StaticCastSharedRef<SFPObjectTableListView>(OwnerTable)->RequestLoad(Reference);
+	}
 }
 
-TSharedRef<SWidget> SFPObjectTableRow::GenerateWidgetForColumn(const FName& ColumnName)
+SFPObjectTableRow::~SFPObjectTableRow()
 {
-	TSharedPtr<SWidget> ColumnWidget = SNullWidget::NullWidget;
+	Reference->OnLoaded.RemoveAll(this);
 
-	FSinglePropertyParams Params;
-	Params.NamePlacement = EPropertyNamePlacement::Type::Hidden;
-	FPropertyEditorModule& EditModule = FModuleManager::Get().GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	// scrolled out of view before it loaded, make way for the rows in view
+	if (!Reference->OnLoaded.IsBound() && Reference->IsLoading())
+	{
+		Reference->LoadHandle->CancelHandle();
+		Reference->LoadHandle.Reset();
+	}
+}
 
-	TSharedRef<SHorizontalBox> HBox = SNew(SHorizontalBox);
+void SFPObjectTableRow::HandleObjLoaded()
+{
+	UObject* Obj = Reference->GetLoadedObj();
+	for (const TPair<FName, TSharedPtr<SBox>>& Pending : PendingCells)
+	{
+		const FName ColumnName = Pending.Key;
+		const FFPColumnDescriptor* Column = Columns->FindByPredicate([ColumnName](const FFPColumnDescriptor& Other) { return Other.ColumnId == ColumnName; });
+		Pending.Value->SetContent(Obj && Column ? MakeCellWidget(*Column, Obj) : SNullWidget::NullWidget);
+	}
+
+	PendingCells.Empty();
+}
+
+TSharedRef<SWidget> SFPObjectTableRow::GenerateWidgetForColumn(const FName& ColumnName)
+{
+	TSharedPtr<SWidget> ColumnWidget = SNullWidget::NullWidget;
 
 	if (ColumnName == TEXT("___FPRowName"))
 	{
-		ColumnWidget = SAssignNew(InlineEditableText, SInlineEditableTextBlock)
-			.IsReadOnly(false)
-			.Text(this, &SFPObjectTableRow::GetObjectName)
-			.OnTextCommitted(this, &SFPObjectTableRow::HandleRename);
+		TSharedPtr<FFPObjectData> Row = Reference;
+		ColumnWidget = SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			[
+				SAssignNew(InlineEditableText, SInlineEditableTextBlock)
+				.IsReadOnly(false)
+				.Text(this, &SFPObjectTableRow::GetObjectName)
+				.OnTextCommitted(this, &SFPObjectTableRow::HandleRename)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(SCircularThrobber)
+				.Radius(6.0f)
+				.Visibility_Lambda([Row] { return Row->IsLoading() ? EVisibility::HitTestInvisible : EVisibility::Collapsed; })
+			];
 	}
 	else
 	{
-		if (UObject* Obj = Reference->GetObj())
+		const FFPColumnDescriptor* Column = Columns->FindByPredicate([&ColumnName](const FFPColumnDescriptor& Other) { return Other.ColumnId == ColumnName; });
+		if (Column)
 		{
-			if (FProperty* Property = FindFProperty<FProperty>(Obj->GetClass(), ColumnName))
+			if (UObject* Obj = Reference->GetLoadedObj())
 			{
-				bool bDoesPropertyHaveSupportedClass =
-					!Property->IsA(FMapProperty::StaticClass()) &&
-					!Property->IsA(FArrayProperty::StaticClass()) &&
-					!Property->IsA(FSetProperty::StaticClass());
-
-				const FStructProperty* StructProp = CastField<const FStructProperty>(Property);
-				if (StructProp && StructProp->Struct)
-				{
-					FName StructName = StructProp->Struct->GetFName();
-					bDoesPropertyHaveSupportedClass = StructName == NAME_Rotator || 
-								 StructName == NAME_Color ||  
-								 StructName == NAME_LinearColor || 
-								 StructName == NAME_Vector ||
-								 StructName == NAME_Quat ||
-								 StructName == NAME_Vector4 ||
-								 StructName == NAME_Vector2D ||
-								 StructName == NAME_IntPoint;
-
-					FPropertyEditorModule& PropertyEditorModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
-					if (PropertyEditorModule.IsCustomizedStruct(StructProp->Struct, FCustomPropertyTypeLayoutMap()))
-					{
-						bDoesPropertyHaveSupportedClass = true;
-					}
-				}
+				ColumnWidget = MakeCellWidget(*Column, Obj);
+			}
+			else
+			{
+				// filled in once the asset loads
+				TSharedPtr<SBox> Placeholder = SNew(SBox)
+				[
+					SNew(STextBlock).Text(INVTEXT("...")).ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				];
 
-				if (bDoesPropertyHaveSupportedClass)
-				{
-					if (TSharedPtr<class ISinglePropertyView> PropWidget = EditModule.CreateSingleProperty(Obj, ColumnName, Params))
-					{
-						if (PropWidget->HasValidProperty())
-						{
-							ColumnWidget = SNew(SFPPropertyValueContainer, Obj, Property)
-							[
-								PropWidget.ToSharedRef()
-							];
-						}
-					}
-				}
-				else if (Property->ContainsInstancedObjectProperty())
-				{
-					ColumnWidget = SNew(STextBlock).Text(INVTEXT("Instanced Property")).ColorAndOpacity(FLinearColor::Red);
-				}
-
-				if (ColumnWidget == SNullWidget::NullWidget)
-				{
-					ColumnWidget = SNew(SFPPropertyValueContainer, Obj, Property)
-					[
-						SNew(SFPPropertyText, Obj, Property)
-					];
-				}
+				PendingCells.Add(ColumnName, Placeholder);
+				ColumnWidget = Placeholder;
 			}
 		}
 	}
@@ -278,6 +521,24 @@ TSharedRef<SWidget> SFPObjectTableRow::GenerateWidgetForColumn(const FName& Colu
 		];
 }
 
+TSharedRef<SWidget> SFPObjectTableRow::MakeCellWidget(const FFPColumnDescriptor& Column, UObject* Obj)
+{
+	if (!Obj->IsA(Column.Property->GetOwnerClass()))
+	{
+		return SNullWidget::NullWidget;
+	}
+
+	if (Column.Renderer == EFPCellRenderer::Instanced)
+	{
+		return SNew(STextBlock).Text(INVTEXT("Instanced Property")).ColorAndOpacity(FLinearColor::Red);
+	}
+
+	return SNew(SFPPropertyValueContainer, Obj, Column.Property)
+		[
+			SNew(SFPPropertyCell, Obj, Column.Property, Column.Renderer, Column.bUseSinglePropertyView).Dispatcher(Dispatcher)
+		];
+}
+
 void SFPObjectTableRow::HandleRename(const FText& Text, ETextCommit::Type CommitMethod)
 {
 	if (CommitMethod == ETextCommit::Type::OnEnter)
@@ -315,6 +576,7 @@ FReply SFPObjectTableRow::OnMouseButtonDoubleClick(const FGeometry& InMyGeometry
 void SFPObjectTableListView::Construct(const FArguments& InArgs, UFPObjectTable* InTableSettings)
 {
 	ObjectTable = InTableSettings;
+	Dispatcher = InArgs._Dispatcher;
 
 	SAssignNew(HeaderRowWidget, SHeaderRow).ResizeMode(ESplitterResizeMode::Fill);
 
@@ -332,9 +594,12 @@ void SFPObjectTableListView::Refresh(UFPObjectTable* TableSettings)
 	Rows.Empty();
 	if (!TableSettings->ClassFilter)
 	{
+		Columns = MakeShared<TArray<FFPColumnDescriptor>>();
 		return;
 	}
 
+	TSharedRef<TArray<FFPColumnDescriptor>> NewColumns = MakeShared<TArray<FFPColumnDescriptor>>();
+
 	HeaderRowWidget->ClearColumns();
 	HeaderRowWidget->AddColumn(
 		SHeaderRow::Column(FName(TEXT("___FPRowName")))
@@ -359,8 +624,16 @@ void SFPObjectTableListView::Refresh(UFPObjectTable* TableSettings)
 		ColumnArgs.OverflowPolicy(ETextOverflowPolicy::MultilineEllipsis);
 		ColumnArgs.HeaderContentPadding(FMargin(8.f, 2.f));
 		HeaderRowWidget->AddColumn(ColumnArgs);
+
+		FFPColumnDescriptor& Column = NewColumns->AddDefaulted_GetRef();
+		Column.ColumnId = PropertyIt->GetFName();
+		Column.Property = *PropertyIt;
+		Column.Renderer = ObjectTableUtils::GetCellRenderer(*PropertyIt);
+		Column.bUseSinglePropertyView = ObjectTableUtils::CanUseSinglePropertyView(*PropertyIt);
 	}
 
+	Columns = NewColumns;
+
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 
 	FString RelativePath = TableSettings->RootDirectory.Path;
@@ -467,19 +740,46 @@ void SFPObjectTableListView::RenameAsset(const FAssetData& Asset, const FString&
 	RequestListRefresh();
 }
 
-TArray<UObject*> SFPObjectTableListView::GetSelectedObjects()
+TArray<UObject*> SFPObjectTableListView::GetSelectedObjects(bool bLoad)
 {
 	TArray<UObject*> OutObjs;
 	for (TSharedPtr<FFPObjectData> Row : SelectedItems)
 	{
-		if (Row->GetObj())
+		if (UObject* Obj = bLoad ? Row->GetObj() : Row->GetLoadedObj())
 		{
-			OutObjs.Add(Row->GetObj());
+			OutObjs.Add(Obj);
 		}
 	}
 	return OutObjs;
 }
 
+void SFPObjectTableListView::RequestLoad(const TSharedPtr<FFPObjectData>& Row)
+{
+	if (Row->IsLoading() || Row->GetLoadedObj())
+	{
+		return;
+	}
+
+	// the delegate may run before the handle is returned when the package is already in memory
+	TWeakPtr<FFPObjectData> WeakRow = Row;
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+		Row->AssetData.GetSoftObjectPath(),
+		FStreamableDelegate::CreateLambda([WeakRow]
+		{
+			if (TSharedPtr<FFPObjectData> LoadedRow = WeakRow.Pin())
+			{
+				LoadedRow->LoadHandle.Reset();
+				LoadedRow->OnLoaded.Broadcast();
+			}
+		}),
+		++NextLoadPriority);
+
+	if (Handle.IsValid() && Handle->IsLoadingInProgress())
+	{
+		Row->LoadHandle = Handle;
+	}
+}
+
 TArray<FAssetData> SFPObjectTableListView::GetSelectedAssets()
 {
 	TArray<FAssetData> OutObjs;
@@ -493,7 +793,7 @@ TArray<FAssetData> SFPObjectTableListView::GetSelectedAssets()
 TSharedRef<ITableRow> SFPObjectTableListView::OnGenerateRow(TSharedPtr<FFPObjectData> InDisplayNode, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	// UE_LOG(LogTemp, Warning, TEXT("Generate row %s"), *GetNameSafe(InDisplayNode->GetObj()));
-	return SNew(SFPObjectTableRow, InDisplayNode, OwnerTable);
+	return SNew(SFPObjectTableRow, InDisplayNode, Columns, OwnerTable).Dispatcher(Dispatcher);
 }
 
 void SFPToggleButtons::Construct(const FArguments& InArgs)
@@ -641,7 +941,11 @@ void SFPObjectTableEditor::Construct(const FArguments& InArgs)
 
 	DetailsView = PropertyEditorModule.CreateDetailView(ViewArgs);
 
-	ObjectTable = SNew(SFPObjectTableListView, TableSettings);
+	// one subscription to property changes for all the cells of this table
+	PropertyChangeDispatcher = MakeShared<FFPPropertyChangeDispatcher>();
+	PropertyChangeDispatcher->Start();
+
+	ObjectTable = SNew(SFPObjectTableListView, TableSettings).Dispatcher(PropertyChangeDispatcher);
 	ObjectTable->MyOnSelectionChanged().BindRaw(this, &SFPObjectTableEditor::OnSelectionChanged);
 	ObjectTable->Refresh(TableSettings);
 
@@ -745,10 +1049,31 @@ TSharedRef<SDockTab> SFPObjectTableEditor::CreateTab(const FSpawnTabArgs& Args)
 }
 
 void SFPObjectTableEditor::OnSelectionChanged(TSharedPtr<FFPObjectData> ObjectData, ESelectInfo::Type SelectInfo)
+{
+	if (!ObjectTable.IsValid() || !DetailsView.IsValid())
+	{
+		return;
+	}
+
+	// the details show what is loaded now and catch up as the rest of the selection loads
+	for (const TSharedPtr<FFPObjectData>& Item : ObjectTable->GetSelectedItems())
+	{
+		if (!Item->GetLoadedObj())
+		{
+			Item->OnLoaded.RemoveAll(this);
+			Item->OnLoaded.AddSP(this, &SFPObjectTableEditor::UpdateDetailsView);
+			ObjectTable->RequestLoad(Item);
+		}
+	}
+
+	UpdateDetailsView();
+}
+
+void SFPObjectTableEditor::UpdateDetailsView()
 {
 	if (ObjectTable.IsValid() && DetailsView.IsValid())
 	{
-		DetailsView.Get()->SetObjects(ObjectTable->GetSelectedObjects(), true);
+		DetailsView.Get()->SetObjects(ObjectTable->GetSelectedObjects(false), true);
 	}
 }
 
@@ -1014,13 +1339,76 @@ TOptional<FString> ObjectTableUtils::GetPropertyCategory(FProperty* Property)
 	return TOptional<FString>();
 }
 
+bool ObjectTableUtils::CanUseSinglePropertyView(const FProperty* Property)
+{
+	bool bDoesPropertyHaveSupportedClass =
+		!Property->IsA(FMapProperty::StaticClass()) &&
+		!Property->IsA(FArrayProperty::StaticClass()) &&
+		!Property->IsA(FSetProperty::StaticClass());
+
+	const FStructProperty* StructProp = CastField<const FStructProperty>(Property);
+	if (StructProp && StructProp->Struct)
+	{
+		FName StructName = StructProp->Struct->GetFName();
+		bDoesPropertyHaveSupportedClass = StructName == NAME_Rotator || 
+					 StructName == NAME_Color ||  
+					 StructName == NAME_LinearColor || 
+					 StructName == NAME_Vector ||
+					 StructName == NAME_Quat ||
+					 StructName == NAME_Vector4 ||
+					 StructName == NAME_Vector2D ||
+					 StructName == NAME_IntPoint;
+
+		FPropertyEditorModule& PropertyEditorModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+		if (PropertyEditorModule.IsCustomizedStruct(StructProp->Struct, FCustomPropertyTypeLayoutMap()))
+		{
+			bDoesPropertyHaveSupportedClass = true;
+		}
+	}
+
+	return bDoesPropertyHaveSupportedClass;
+}
+
+EFPCellRenderer ObjectTableUtils::GetCellRenderer(const FProperty* Property)
+{
+	if (!CanUseSinglePropertyView(Property) && Property->ContainsInstancedObjectProperty())
+	{
+		return EFPCellRenderer::Instanced;
+	}
+
+	if (Property->IsA<FBoolProperty>())
+	{
+		return EFPCellRenderer::Bool;
+	}
+
+	if (const FNumericProperty* NumericProp = CastField<const FNumericProperty>(Property))
+	{
+		return NumericProp->IsEnum() ? EFPCellRenderer::Text : EFPCellRenderer::Number;
+	}
+
+	if (const FStructProperty* StructProp = CastField<const FStructProperty>(Property))
+	{
+		if (StructProp->Struct == TBaseStructure<FColor>::Get() || StructProp->Struct == TBaseStructure<FLinearColor>::Get())
+		{
+			return EFPCellRenderer::Color;
+		}
+	}
+
+	if (Property->IsA<FObjectPropertyBase>())
+	{
+		return EFPCellRenderer::Object;
+	}
+
+	return EFPCellRenderer::Text;
+}
+
 FReply SFPObjectTableEditor::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent)
 {
 	TArray<TSharedPtr<FFPObjectData>> SelectedItems = ObjectTable->GetSelectedItems();
 	if (SelectedItems.Num() == 1)
 	{
 		TSharedPtr<FFPObjectData> SelectedItem = SelectedItems[0];
-		if (SelectedItem->GetObj())
+		if (SelectedItem->AssetData.IsValid())
 		{
 			if (InKeyEvent.GetKey() == EKeys::F2)
 			{
@@ -1033,7 +1421,7 @@ FReply SFPObjectTableEditor::OnKeyDown(const FGeometry& MyGeometry, const FKeyEv
 			if (InKeyEvent.GetKey() == EKeys::B && FSlateApplication::Get().GetModifierKeys().IsControlDown())
 			{
 				// Highlight the asset in content browser
-				const TArray<UObject*>& Assets = {SelectedItem->GetObj()};
+				const TArray<FAssetData> Assets = {SelectedItem->AssetData};
 				const FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
 				ContentBrowserModule.Get().SyncBrowserToAssets(Assets, false, true);
 				return FReply::Handled();
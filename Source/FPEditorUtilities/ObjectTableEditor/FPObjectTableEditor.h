@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "IPropertyTable.h"
 #include "FPObjectTable.h"
+#include "Engine/StreamableManager.h"
 #include "Filters/SBasicFilterBar.h"
 #include "Widgets/Layout/SWrapBox.h"
 
@@ -15,7 +16,48 @@ class FFPObjectData : public TSharedFromThis<FFPObjectData>
 public:
 	FAssetData AssetData;
 
+	/** Loads the asset if needed, only for actions which can't go on without the object */
 	UObject* GetObj();
+
+	/** Null until the asset is loaded */
+	UObject* GetLoadedObj() const;
+
+	bool IsLoading() const { return LoadHandle.IsValid() && LoadHandle->IsLoadingInProgress(); }
+
+	/** Started by SFPObjectTableListView::RequestLoad */
+	TSharedPtr<FStreamableHandle> LoadHandle;
+	FSimpleMulticastDelegate OnLoaded;
+};
+
+/**
+ * Subscribes once to the global property change and undo events for a table editor, and tells only the cells showing
+ * the changed property of the changed object
+ */
+class FFPPropertyChangeDispatcher : public TSharedFromThis<FFPPropertyChangeDispatcher>
+{
+public:
+	void Start();
+	~FFPPropertyChangeDispatcher();
+
+	/** OnChanged should be bound to the cell (CreateSP), the listener is dropped once the cell is gone */
+	void Add(const UObject* Object, FName PropertyName, FSimpleDelegate OnChanged);
+	void RemoveExpired(const UObject* Object);
+
+private:
+	struct FListener
+	{
+		FName PropertyName;
+		FSimpleDelegate OnChanged;
+	};
+
+	/** Notifies every listener of the object when PropertyName is none */
+	void Notify(const UObject* Object, FName PropertyName);
+
+	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& ChangeEvent);
+	void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionObjectEvent);
+
+	/** The live cells of each object, a handful per object so the properties are searched in place */
+	TMap<TObjectKey<UObject>, TArray<FListener>> Listeners;
 };
 
 class SFPPropertyValueContainer : public SCompoundWidget
@@ -40,6 +82,7 @@ public:
 	SLATE_BEGIN_ARGS(SFPPropertyText)
 	{
 	}
+		SLATE_ARGUMENT(TSharedPtr<FFPPropertyChangeDispatcher>, Dispatcher)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, UObject* Obj, FProperty* Property);
@@ -49,13 +92,69 @@ public:
 
 	void HandleTextCommitted(const FText& Text, ETextCommit::Type Arg);
 
-	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& ChangeEvent);
-	void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionObjectEvent);
 	virtual FReply OnMouseButtonDoubleClick(const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent) override;
 
 	TSharedPtr<SInlineEditableTextBlock> EditableTextBlock;
+	TWeakPtr<FFPPropertyChangeDispatcher> Dispatcher;
+	UObject* Obj = nullptr;
+	FProperty* Prop = nullptr;
+};
+
+/** How a cell shows its value until it is edited */
+enum class EFPCellRenderer : uint8
+{
+	Text,
+	Number,
+	Bool,
+	Color,
+	Object,
+	Instanced,
+};
+
+/** Shows the value with one small read only widget, the property editor is only made once the cell is focused or double clicked */
+class SFPPropertyCell : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SFPPropertyCell)
+	{
+	}
+		SLATE_ARGUMENT(TSharedPtr<FFPPropertyChangeDispatcher>, Dispatcher)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UObject* InObj, FProperty* InProperty, EFPCellRenderer InRenderer, bool bInUseSinglePropertyView);
+	virtual ~SFPPropertyCell() override;
+
+	virtual bool SupportsKeyboardFocus() const override { return !bEditing; }
+	virtual FReply OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent) override;
+	virtual FReply OnMouseButtonDoubleClick(const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent) override;
+
+	void SyncValue();
+	void StartEditing(bool bEnterTextEditing);
+
+	TSharedRef<SWidget> MakeValueWidget();
+	FText GetValueText() const { return ValueText; }
+	FLinearColor GetValueColor() const { return ValueColor; }
+	const FSlateBrush* GetBoolBrush() const;
+
+	TWeakPtr<FFPPropertyChangeDispatcher> Dispatcher;
 	UObject* Obj = nullptr;
 	FProperty* Prop = nullptr;
+	EFPCellRenderer Renderer = EFPCellRenderer::Text;
+	bool bUseSinglePropertyView = false;
+	bool bEditing = false;
+
+	FText ValueText;
+	FLinearColor ValueColor = FLinearColor::Black;
+	bool bValue = false;
+};
+
+/** A checked column of the table, resolved once per refresh and shared by the rows */
+struct FFPColumnDescriptor
+{
+	FName ColumnId;
+	FProperty* Property = nullptr;
+	EFPCellRenderer Renderer = EFPCellRenderer::Text;
+	bool bUseSinglePropertyView = false;
 };
 
 class SFPObjectTableRow : public SMultiColumnTableRow<TSharedPtr<FFPObjectData>>
@@ -64,13 +163,17 @@ public:
 	SLATE_BEGIN_ARGS(SFPObjectTableRow)
 		{
 		}
+		SLATE_ARGUMENT(TSharedPtr<FFPPropertyChangeDispatcher>, Dispatcher)
 
 	SLATE_END_ARGS()
 
 public:
-	void Construct(const FArguments& InArgs, TSharedPtr<FFPObjectData> InReference, const TSharedRef<STableViewBase>& OwnerTable);
+	void Construct(const FArguments& InArgs, TSharedPtr<FFPObjectData> InReference, TSharedRef<const TArray<FFPColumnDescriptor>> InColumns, const TSharedRef<STableViewBase>& OwnerTable);
+	virtual ~SFPObjectTableRow() override;
 
 	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
+	TSharedRef<SWidget> MakeCellWidget(const FFPColumnDescriptor& Column, UObject* Obj);
+	void HandleObjLoaded();
 
 	void HandleRename(const FText& Text, ETextCommit::Type CommitMethod);
 
@@ -82,6 +185,11 @@ public:
 
 	TSharedPtr<SInlineEditableTextBlock> InlineEditableText;
 	TSharedPtr<FFPObjectData> Reference;
+	TSharedPtr<const TArray<FFPColumnDescriptor>> Columns;
+	TSharedPtr<FFPPropertyChangeDispatcher> Dispatcher;
+
+	/** Placeholder cells of a row whose asset is still loading */
+	TMap<FName, TSharedPtr<SBox>> PendingCells;
 };
 
 class SFPObjectTableListView : public SListView<TSharedPtr<FFPObjectData>>
@@ -89,7 +197,8 @@ class SFPObjectTableListView : public SListView<TSharedPtr<FFPObjectData>>
 	SLATE_BEGIN_ARGS(SFPObjectTableListView)
 		{
 		}
-	
+		SLATE_ARGUMENT(TSharedPtr<FFPPropertyChangeDispatcher>, Dispatcher)
+
 	SLATE_END_ARGS()
 
 public:
@@ -100,9 +209,13 @@ public:
 	void RemoveAsset(const FAssetData& AssetData);
 	void RenameAsset(const FAssetData& Asset, const FString& NewName);
 
-	TArray<UObject*> GetSelectedObjects();
+	/** bLoad blocks on the selected assets which aren't loaded, otherwise they are left out */
+	TArray<UObject*> GetSelectedObjects(bool bLoad = true);
 	TArray<FAssetData> GetSelectedAssets();
 
+	/** Rows ask for their asset when they come into view, the newest requests load first */
+	void RequestLoad(const TSharedPtr<FFPObjectData>& Row);
+
 	FOnSelectionChanged& MyOnSelectionChanged() { return OnSelectionChanged; }
 
 protected:
@@ -112,6 +225,14 @@ private:
 	TSharedPtr<SHeaderRow> HeaderRowWidget;
 	TArray<TSharedPtr<FFPObjectData>> Rows;
 
+	/** Replaced on each refresh, rows made before it keep the columns they were made with */
+	TSharedRef<const TArray<FFPColumnDescriptor>> Columns = MakeShared<TArray<FFPColumnDescriptor>>();
+
+	TSharedPtr<FFPPropertyChangeDispatcher> Dispatcher;
+
+	FStreamableManager StreamableManager;
+	int32 NextLoadPriority = 0;
+
 	UFPObjectTable* ObjectTable = nullptr;
 };
 
@@ -172,6 +293,7 @@ public:
 	TSharedPtr<IPropertyTable> NewPropertyTable;
 	TSharedPtr<SFPObjectTableListView> ObjectTable;
 	TSharedPtr<IDetailsView> DetailsView;
+	TSharedPtr<FFPPropertyChangeDispatcher> PropertyChangeDispatcher;
 
 	TSharedPtr<SFPToggleButtons> DetailViewButtons;
 	TSharedPtr<SFPToggleButtons> PropertyButtons;
@@ -181,6 +303,7 @@ public:
 	TSharedPtr<SBasicFilterBar<FText>> FilterBar;
 
 	void OnSelectionChanged(TSharedPtr<FFPObjectData> ObjectData, ESelectInfo::Type SelectInfo);
+	void UpdateDetailsView();
 
 	FReply HandleNewClassClicked();
 	FReply HandleDeleteClicked();
@@ -201,4 +324,9 @@ public:
 namespace ObjectTableUtils
 {
 	static TOptional<FString> GetPropertyCategory(FProperty* Property);
+
+	/** Whether the property editor handles this type on a single line, otherwise cells edit it as text */
+	static bool CanUseSinglePropertyView(const FProperty* Property);
+
+	static EFPCellRenderer GetCellRenderer(const FProperty* Property);
 }